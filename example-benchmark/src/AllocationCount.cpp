@@ -0,0 +1,24 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Every allocation made through operator new is counted so that the benchmark can report allocations per operation.
+std::atomic<uint64_t> allocationCount(0);
+
+void* operator new(std::size_t size)
+{
+	allocationCount++;
+	if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
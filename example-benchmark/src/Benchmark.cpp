@@ -0,0 +1,412 @@
+#include "Benchmark.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Values used to populate the collections, one overload per benchmarked type.
+template<typename ParameterType>
+ParameterType makeValue(size_t i);
+
+template<>
+int makeValue<int>(size_t i) {
+	return int(i);
+}
+
+template<>
+float makeValue<float>(size_t i) {
+	return i * 0.5f;
+}
+
+template<>
+glm::vec2 makeValue<glm::vec2>(size_t i) {
+	return glm::vec2(i, i * 0.5f);
+}
+
+template<>
+ofColor makeValue<ofColor>(size_t i) {
+	return ofColor(i % 256, (i / 256) % 256, 128);
+}
+
+template<>
+std::string makeValue<std::string>(size_t i) {
+	return "Item value " + ofToString(i);
+}
+
+// Something cheap to accumulate while iterating, so the loop can't be optimized away.
+inline size_t checksum(int value) { return value; }
+inline size_t checksum(float value) { return size_t(value); }
+inline size_t checksum(const glm::vec2& value) { return size_t(value.x + value.y); }
+inline size_t checksum(const ofColor& value) { return value.r + value.g + value.b; }
+inline size_t checksum(const std::string& value) { return value.size(); }
+
+// Binary I/O is only available for trivially copyable types, so it is only benchmarked for those.
+template<typename ParameterType>
+void benchmarkBinary(Benchmark& app, ofxParameterCollection<ParameterType>& collection, const std::string& typeName,
+					 size_t size, size_t repetitions, std::true_type) {
+	std::stringstream stream;
+	app.report(typeName, "writeValues", size, app.measure(repetitions, 1, [&]() {
+		stream.str("");
+		stream.clear();
+	}, [&]() {
+		collection.writeValues(stream);
+	}));
+
+	std::string data = stream.str();
+	app.report(typeName, "readValues", size, app.measure(repetitions, 1, [&]() {
+		stream.str(data);
+		stream.clear();
+	}, [&]() {
+		collection.readValues(stream, false);
+	}));
+	app.check(collection.size() == size, typeName, "readValues restores the item count", size);
+
+	ofXml xml;
+	ofSerialize(xml, collection.getGroup());
+	const std::string xmlPath = "benchmark-" + ofToString(size) + ".xml";
+	xml.save(xmlPath);
+	const std::string cachePath = ofToDataPath(collection.getCachePath(xmlPath));
+	app.report(typeName, "loadCached/xml", size, app.measure(repetitions, 1, [&]() {
+		std::remove(cachePath.c_str());
+	}, [&]() {
+		collection.loadCached(xmlPath, false);
+	}));
+
+	app.report(typeName, "loadCached/cache", size, app.measure(repetitions, 1, []() {}, [&]() {
+		collection.loadCached(xmlPath, false);
+	}));
+	collection.clear(false);
+	app.check(collection.loadCached(xmlPath, false) && collection.size() == size, typeName,
+			  "loadCached restores the item count", size);
+	std::remove(cachePath.c_str());
+	std::remove(ofToDataPath(xmlPath).c_str());
+}
+
+template<typename ParameterType>
+void benchmarkBinary(Benchmark&, ofxParameterCollection<ParameterType>&, const std::string&, size_t, size_t,
+					 std::false_type) {
+}
+
+// The compact XML layouts are also limited to trivially copyable types.
+template<typename ParameterType>
+void benchmarkCompact(Benchmark& app, ofxParameterCollection<ParameterType>& collection, const std::vector<ParameterType>& values,
+					  const std::string& typeName, size_t size, size_t repetitions, std::true_type) {
+	using Format = typename ofxParameterCollection<ParameterType>::SerializationFormat;
+	for (auto format : {Format::CompactText, Format::CompactBinary}) {
+		std::string suffix = format == Format::CompactText ? "/csv" : "/base64";
+		collection.setSerializationFormat(format);
+		ofXml xml;
+		app.report(typeName, "serialize" + suffix, size, app.measure(repetitions, 1, []() {}, [&]() {
+			collection.serialize(xml);
+		}));
+
+		app.report(typeName, "deserialize" + suffix, size, app.measure(repetitions, 1, []() {}, [&]() {
+			collection.deserialize(xml, false);
+		}));
+
+		collection.clear(false);
+		collection.deserialize(xml, false);
+		bool roundTrip = collection.size() == size;
+		for (size_t i = 0; roundTrip && i < size; i++) {
+			roundTrip = collection.getAt(i)->get() == values[i];
+		}
+		app.check(roundTrip, typeName, "compact" + suffix + " round trip", size);
+	}
+	collection.setSerializationFormat(Format::Items);
+}
+
+template<typename ParameterType>
+void benchmarkCompact(Benchmark&, ofxParameterCollection<ParameterType>&, const std::vector<ParameterType>&,
+					  const std::string&, size_t, size_t, std::false_type) {
+}
+
+//--------------------------------------------------------------
+Benchmark::Benchmark(size_t maxSize) {
+	for (size_t size = 10; size <= maxSize; size *= 10) {
+		sizes.push_back(size);
+	}
+}
+
+//--------------------------------------------------------------
+int Benchmark::run() {
+	std::cout << std::left << std::setw(12) << "type" << std::setw(20) << "operation" << std::right
+			  << std::setw(10) << "size" << std::setw(16) << "ns/op" << std::setw(16) << "allocs/op" << std::endl;
+
+	runBenchmarks<int>("int");
+	runBenchmarks<float>("float");
+	runBenchmarks<glm::vec2>("glm::vec2");
+	runBenchmarks<ofColor>("ofColor");
+	runBenchmarks<std::string>("std::string");
+
+	if (failures > 0) {
+		ofLogError("example-benchmark") << failures << " checks failed";
+	}
+	return failures;
+}
+
+//--------------------------------------------------------------
+int Benchmark::runTests() {
+	// One repetition per operation is enough to exercise the checks
+	quiet = true;
+	sizes = {10, 100};
+	runBenchmarks<int>("int");
+	runBenchmarks<float>("float");
+	runBenchmarks<glm::vec2>("glm::vec2");
+	runBenchmarks<ofColor>("ofColor");
+	runBenchmarks<std::string>("std::string");
+
+	testBulkOperations();
+	testPresets();
+	testParallel();
+	testRemoveIf();
+	testReorder();
+	testAnimations();
+	testReloadValues();
+	testSpatialIndex();
+	testRecorder();
+	testMemoryUsage();
+	testFixedCollection();
+	testCodec();
+	testStats();
+	testTrace();
+
+	if (failures > 0) {
+		ofLogError("example-benchmark") << failures << " checks failed";
+	} else {
+		std::cout << "All checks passed" << std::endl;
+	}
+	return failures;
+}
+
+//--------------------------------------------------------------
+template<typename Prepare, typename Operation>
+Benchmark::Result Benchmark::measure(size_t repetitions, size_t opsPerRepetition, Prepare prepare, Operation operation) {
+	uint64_t nanoseconds = 0;
+	uint64_t allocations = 0;
+	for (size_t r = 0; r < repetitions; r++) {
+		prepare();
+		uint64_t allocationsBefore = allocationCount;
+		auto start = std::chrono::steady_clock::now();
+		operation();
+		auto end = std::chrono::steady_clock::now();
+		allocations += allocationCount - allocationsBefore;
+		nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	}
+	double ops = double(repetitions) * opsPerRepetition;
+	return {nanoseconds / ops, allocations / ops};
+}
+
+//--------------------------------------------------------------
+template<typename ParameterType>
+void Benchmark::runBenchmarks(const std::string& typeName) {
+	for (auto size : sizes) {
+		ofParameterGroup root;
+		root.setName("Benchmark");
+		ofxParameterCollection<ParameterType> collection;
+		collection.setup("Item ", "Collection", root);
+
+		std::vector<ParameterType> values(size);
+		for (size_t i = 0; i < size; i++) {
+			values[i] = makeValue<ParameterType>(i);
+		}
+
+		auto fill = [&]() {
+			while (collection.size() < size) {
+				collection.addItem(values[collection.size()], false);
+			}
+		};
+
+		// Cheap operations are repeated more times on small collections to get stable numbers
+		size_t repetitions = quiet ? 1 : std::max<size_t>(1, std::min<size_t>(100, 100000 / size));
+
+		report(typeName, "addItem", size, measure(repetitions, size, [&]() {
+			collection.clear(false);
+		}, [&]() {
+			for (size_t i = 0; i < size; i++) {
+				collection.addItem(values[i], false);
+			}
+		}));
+
+		std::string text;
+		report(typeName, "format/ofToString", size, measure(repetitions, size, []() {}, [&]() {
+			for (auto& value : values) {
+				text = ofToString(value);
+			}
+		}));
+
+		report(typeName, "format/codec", size, measure(repetitions, size, []() {}, [&]() {
+			for (auto& value : values) {
+				text.clear();
+				ofxParameterCollectionCodec<ParameterType>::format(value, text);
+			}
+		}));
+
+		std::vector<std::string> texts(size);
+		for (size_t i = 0; i < size; i++) {
+			ofxParameterCollectionCodec<ParameterType>::format(values[i], texts[i]);
+		}
+		ParameterType parsed;
+		report(typeName, "parse/ofFromString", size, measure(repetitions, size, []() {}, [&]() {
+			for (auto& valueText : texts) {
+				parsed = ofFromString<ParameterType>(valueText);
+			}
+		}));
+
+		report(typeName, "parse/codec", size, measure(repetitions, size, []() {}, [&]() {
+			for (auto& valueText : texts) {
+				ofxParameterCollectionCodec<ParameterType>::parse(valueText, parsed);
+			}
+		}));
+
+		bool codecRoundTrip = true;
+		for (size_t i = 0; codecRoundTrip && i < size; i++) {
+			codecRoundTrip = ofxParameterCollectionCodec<ParameterType>::parse(texts[i], parsed) && parsed == values[i];
+		}
+		check(codecRoundTrip, typeName, "codec round trip", size);
+
+		report(typeName, "iterate/item", size, measure(repetitions, size, fill, [&]() {
+			size_t sum = 0;
+			for (auto& param : collection) {
+				sum += checksum(param->get());
+			}
+			volatile size_t sink = sum;
+			(void) sink;
+		}));
+
+		report(typeName, "getParameters", size, measure(repetitions, 1, fill, [&]() {
+			volatile size_t sink = collection.getParameters().size();
+			(void) sink;
+		}));
+
+		report(typeName, "getValuesView", size, measure(repetitions, 1, fill, [&]() {
+			volatile size_t sink = collection.getValuesView().size();
+			(void) sink;
+		}));
+
+		report(typeName, "setValues", size, measure(repetitions, 1, fill, [&]() {
+			collection.setValues(values, false);
+		}));
+
+		report(typeName, "transform", size, measure(repetitions, 1, fill, [&]() {
+			collection.transform([](const ParameterType& value) { return value; }, false);
+		}));
+
+		report(typeName, "parallelTransform", size, measure(repetitions, 1, fill, [&]() {
+			collection.parallelTransform([](const ParameterType& value) { return value; }, false);
+		}));
+
+		report(typeName, "setCollection", size, measure(repetitions, 1, fill, [&]() {
+			collection.setCollection(values, false);
+		}));
+
+		report(typeName, "removeAt", size, measure(repetitions, 1, fill, [&]() {
+			collection.removeAt(size / 2, false);
+		}));
+		collection.setCollection(values, false);
+		collection.removeAt(size / 2, false);
+		check(collection.size() == size - 1, typeName, "removeAt removes one item", size);
+		check(size < 2 || collection.getAt(size / 2)->get() == values[size / 2 + 1], typeName,
+			  "removeAt shifts the following items", size);
+
+		report(typeName, "removeItem", size, measure(repetitions, 1, fill, [&]() {
+			collection.removeItem(collection.back(), false);
+		}));
+
+		std::vector<size_t> evenIndices;
+		for (size_t i = 0; i < size; i += 2) {
+			evenIndices.push_back(i);
+		}
+		report(typeName, "removeIndices", size, measure(repetitions, 1, fill, [&]() {
+			collection.removeIndices(evenIndices, false);
+		}));
+		collection.setCollection(values, false);
+		collection.removeIndices(evenIndices, false);
+		check(collection.size() == size / 2, typeName, "removeIndices removes every listed item", size);
+		check(size < 2 || collection.getAt(0)->get() == values[1], typeName,
+			  "removeIndices keeps the order of the remaining items", size);
+
+		report(typeName, "clear", size, measure(repetitions, 1, fill, [&]() {
+			collection.clear(false);
+		}));
+		check(collection.size() == 0 && collection.getGroup().size() == 0, typeName, "clear empties the group", size);
+
+		fill();
+		ofXml xml;
+		ofSerialize(xml, root);
+		report(typeName, "preDeserialize", size, measure(repetitions, 1, []() {}, [&]() {
+			collection.preDeserialize(xml);
+		}));
+
+		report(typeName, "reconcile", size, measure(repetitions, 1, []() {}, [&]() {
+			collection.preDeserialize(xml, ofxParameterCollection<ParameterType>::PreDeserializeMode::Reconcile);
+		}));
+		check(collection.size() == size, typeName, "reconcile keeps the item count", size);
+
+		report(typeName, "reloadValues", size, measure(repetitions, 1, []() {}, [&]() {
+			collection.reloadValues(xml, false);
+		}));
+
+		ofDeserialize(xml, root);
+		bool roundTrip = collection.size() == size;
+		for (size_t i = 0; roundTrip && i < size; i++) {
+			roundTrip = collection.getAt(i)->toString() == ofToString(values[i]);
+		}
+		check(roundTrip, typeName, "serialization round trip", size);
+
+		report(typeName, "ofSerialize", size, measure(repetitions, 1, []() {}, [&]() {
+			ofSerialize(xml, root);
+		}));
+
+		report(typeName, "serialize", size, measure(repetitions, 1, []() {}, [&]() {
+			collection.serialize(xml);
+		}));
+
+		report(typeName, "ofDeserialize", size, measure(repetitions, 1, []() {}, [&]() {
+			collection.preDeserialize(xml);
+			ofDeserialize(xml, root);
+		}));
+
+		report(typeName, "deserialize", size, measure(repetitions, 1, []() {}, [&]() {
+			collection.deserialize(xml, false);
+		}));
+
+		collection.setParallelParsing(true);
+		report(typeName, "deserialize/par", size, measure(repetitions, 1, []() {}, [&]() {
+			collection.deserialize(xml, false);
+		}));
+		collection.setParallelParsing(false);
+
+		for (bool parallel : {false, true}) {
+			collection.setParallelParsing(parallel);
+			collection.clear(false);
+			collection.deserialize(xml, false);
+			roundTrip = collection.size() == size;
+			for (size_t i = 0; roundTrip && i < size; i++) {
+				roundTrip = collection.getAt(i)->get() == values[i];
+			}
+			check(roundTrip, typeName, parallel ? "parallel deserialize round trip" : "deserialize round trip", size);
+		}
+		collection.setParallelParsing(false);
+
+		benchmarkCompact(*this, collection, values, typeName, size, repetitions,
+						 std::integral_constant<bool, ofxParameterCollectionTraits<ParameterType>::isPacked>());
+
+		fill();
+		benchmarkBinary(*this, collection, typeName, size, repetitions,
+						std::integral_constant<bool, ofxParameterCollectionTraits<ParameterType>::isPacked>());
+	}
+}
+
+//--------------------------------------------------------------
+void Benchmark::check(bool condition, const std::string& typeName, const std::string& what, size_t size) {
+	if (condition) return;
+	ofLogError("example-benchmark") << "Check failed for " << typeName << " with " << size << " items: " << what;
+	failures++;
+}
+
+//--------------------------------------------------------------
+void Benchmark::report(const std::string& typeName, const std::string& operation, size_t size, const Result& result) {
+	if (quiet) return;
+	std::cout << std::left << std::setw(12) << typeName << std::setw(20) << operation << std::right
+			  << std::setw(10) << size << std::setw(16) << std::fixed << std::setprecision(1) << result.nsPerOp
+			  << std::setw(16) << std::setprecision(2) << result.allocationsPerOp << std::endl;
+}
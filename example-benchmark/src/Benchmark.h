@@ -0,0 +1,72 @@
+#pragma once
+
+// Only the parts of OF that the addon depends on, so that the standalone build doesn't need ofMain.
+#include "ofParameter.h"
+#include "ofParameterGroup.h"
+#include "ofXml.h"
+#include "ofColor.h"
+#include "ofUtils.h"
+#include "ofLog.h"
+#include "ofFileUtils.h"
+#include "glm/vec2.hpp"
+#include "ofxParameterCollection.h"
+#include <atomic>
+
+extern std::atomic<uint64_t> allocationCount;
+
+// Measures the public operations of ofxParameterCollection and checks that they leave the collection in the
+// expected state. Used by the openFrameworks app and by the standalone build.
+class Benchmark {
+
+public:
+	// Benchmarks every size from 10 up to maxSize, in powers of 10.
+	Benchmark(size_t maxSize);
+
+	// Runs every benchmark and prints the results. Returns the number of failed checks.
+	int run();
+
+	// Runs the checks of the benchmarks on small collections without printing timings, followed by the feature
+	// tests. Takes a few seconds. Returns the number of failed checks.
+	int runTests();
+
+	struct Result {
+		double nsPerOp;
+		double allocationsPerOp;
+	};
+
+	// Runs operation repetitions times, calling prepare before each repetition outside of the measured time.
+	// opsPerRepetition is the number of operations performed by each call to operation.
+	template<typename Prepare, typename Operation>
+	Result measure(size_t repetitions, size_t opsPerRepetition, Prepare prepare, Operation operation);
+
+	template<typename ParameterType>
+	void runBenchmarks(const std::string& typeName);
+
+	void report(const std::string& typeName, const std::string& operation, size_t size, const Result& result);
+
+	// Records a failure when condition is false.
+	void check(bool condition, const std::string& typeName, const std::string& what, size_t size);
+
+	std::vector<size_t> sizes;
+	int failures = 0;
+	bool quiet = false;
+
+protected:
+	// Feature tests, in BenchmarkTests.cpp
+	void testBulkOperations();
+	void testPresets();
+	void testParallel();
+	void testRemoveIf();
+	void testReorder();
+	void testAnimations();
+	void testReloadValues();
+	void testSpatialIndex();
+	void testRecorder();
+	void testMemoryUsage();
+	void testFixedCollection();
+	void testCodec();
+	// Only checks anything when OFX_PARAMETER_COLLECTION_STATS is defined
+	void testStats();
+	// Only checks anything when OFX_PARAMETER_COLLECTION_TRACING is defined
+	void testTrace();
+};
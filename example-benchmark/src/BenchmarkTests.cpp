@@ -0,0 +1,558 @@
+#include "Benchmark.h"
+#include "ofxFixedParameterCollection.h"
+#include "ofxParameterCollectionRecorder.h"
+#include "ofxParameterCollectionSpatialIndex.h"
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+
+// Feature tests run by Benchmark::runTests. Each one works on a small collection of its own.
+
+namespace {
+
+std::vector<int> valuesOf(ofxParameterCollection<int>& collection) {
+	std::vector<int> values;
+	for (auto& param : collection) {
+		values.push_back(param->get());
+	}
+	return values;
+}
+
+#ifdef OFX_PARAMETER_COLLECTION_TRACING
+std::string readText(const std::string& path) {
+	std::ifstream file(path);
+	std::stringstream text;
+	text << file.rdbuf();
+	return text.str();
+}
+#endif
+
+// Exposes the cell bounds of the grid
+class SpatialIndexProbe : public ofxParameterCollectionSpatialIndex<glm::vec2> {
+public:
+	int getMaxCell(int d) const {
+		return maxCell[d];
+	}
+};
+
+void fill(ofxParameterCollection<int>& collection, const std::vector<int>& values) {
+	collection.clear(false);
+	for (int value : values) {
+		collection.addItem(value, false);
+	}
+}
+
+}
+
+//--------------------------------------------------------------
+void Benchmark::testRemoveIf() {
+	ofParameterGroup root;
+	ofxParameterCollection<int> collection;
+	collection.setup("Item ", "Collection", root);
+	fill(collection, {0, 1, 2, 3, 4, 5, 6, 7});
+
+	size_t changedEvents = 0;
+	size_t removedRanges = 0;
+	size_t itemEvents = 0;
+	auto changedListener = collection.collectionChangedEvent.newListener([&](ofxParameterCollection<int>& c) {
+		changedEvents++;
+		removedRanges = c.getRemovedRanges().size();
+	});
+	auto itemListener = collection.collectionItemChangedEvent.newListener([&](ofParameter<int>&) {
+		itemEvents++;
+	});
+
+	size_t removed = collection.removeIf([](int value) { return value % 2 == 0; });
+	check(removed == 4, "int", "removeIf returns the number of removed items", 8);
+	check(valuesOf(collection) == std::vector<int>({1, 3, 5, 7}), "int", "removeIf keeps the order of the rest", 8);
+	check(collection.getGroup().size() == 4, "int", "removeIf shrinks the group", 8);
+	check(changedEvents == 1 && removedRanges == 4, "int", "removeIf notifies once with the removed ranges", 8);
+	check(itemEvents == 0, "int", "removeIf doesn't fire the events of the shifted items", 8);
+
+	collection.removeIndices(std::vector<size_t>({0, 3}));
+	check(valuesOf(collection) == std::vector<int>({3, 5}), "int", "removeIndices removes the listed items", 4);
+	check(collection.removeIndices(std::vector<size_t>({7})) == 0 && collection.size() == 2, "int",
+		  "removeIndices ignores indices out of bounds", 2);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testReorder() {
+	ofParameterGroup root;
+	ofxParameterCollection<int> collection;
+	collection.setup("Item ", "Collection", root);
+	fill(collection, {10, 20, 30, 40});
+
+	size_t reorderedEvents = 0;
+	size_t itemEvents = 0;
+	std::vector<size_t> permutation;
+	auto reorderedListener = collection.collectionReorderedEvent.newListener([&](ofxParameterCollection<int>& c) {
+		reorderedEvents++;
+		permutation = c.getPermutation();
+	});
+	auto itemListener = collection.collectionItemChangedEvent.newListener([&](ofParameter<int>&) {
+		itemEvents++;
+	});
+
+	collection.move(0, 3);
+	check(valuesOf(collection) == std::vector<int>({20, 30, 40, 10}), "int", "move", 4);
+	check(permutation == std::vector<size_t>({1, 2, 3, 0}), "int", "move reports the permutation", 4);
+
+	collection.swap(0, 3);
+	check(valuesOf(collection) == std::vector<int>({10, 30, 40, 20}), "int", "swap", 4);
+	check(permutation == std::vector<size_t>({3, 1, 2, 0}), "int", "swap reports the permutation", 4);
+
+	collection.sort(std::greater<int>());
+	check(valuesOf(collection) == std::vector<int>({40, 30, 20, 10}), "int", "sort", 4);
+	check(permutation == std::vector<size_t>({2, 1, 3, 0}), "int", "sort reports the permutation", 4);
+	check(reorderedEvents == 3 && itemEvents == 0, "int", "reorders notify once, through the reordered event", 4);
+	check(collection.getAt(0)->getName() == "Item 0", "int", "reordering keeps the item names", 4);
+	check(!collection.move(0, 4) && !collection.swap(4, 0), "int", "reorders reject indices out of bounds", 4);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testAnimations() {
+	using Easing = ofxParameterCollection<float>::Easing;
+	ofParameterGroup root;
+	ofxParameterCollection<float> collection;
+	collection.setup("Item ", "Collection", root);
+	collection.setCollection(std::vector<float>({0, 0, 0}), false);
+
+	size_t valueEvents = 0;
+	auto listener = collection.collectionValuesChangedEvent.newListener([&](ofxParameterCollection<float>&) {
+		valueEvents++;
+	});
+
+	float now = ofGetElapsedTimef();
+	collection.animateTo(0, 10, 1, Easing::Linear);
+	collection.animateTo(1, 10, 1, Easing::QuadIn);
+	collection.animateTo(2, 10, 1, Easing::SineInOut, 1);
+	collection.updateAnimations(now + 0.5f);
+	check(std::abs(collection.getAt(0)->get() - 5) < 0.1f, "float", "linear tween at the halfway point", 3);
+	check(std::abs(collection.getAt(1)->get() - 2.5f) < 0.1f, "float", "eased tween at the halfway point", 3);
+	check(collection.getAt(2)->get() == 0, "float", "a delayed tween doesn't start early", 3);
+	check(valueEvents == 1, "float", "updateAnimations notifies once", 3);
+
+	collection.updateAnimations(now + 3);
+	check(collection.getAt(0)->get() == 10 && collection.getAt(2)->get() == 10, "float", "tweens end on the target", 3);
+	check(!collection.isAnimating(), "float", "finished tweens are removed", 3);
+
+	// Removing an item while another one is animating: the tween follows its item to its new index
+	collection.setCollection(std::vector<float>({0, 0, 0, 0}), false);
+	now = ofGetElapsedTimef();
+	collection.animateTo(2, 10, 1);
+	collection.removeAt(0);
+	collection.updateAnimations(now + 2);
+	check(collection.getAt(1)->get() == 10 && collection.getAt(2)->get() == 0, "float",
+		  "removeAt keeps the tweens on their items", 3);
+
+	collection.setCollection(std::vector<float>({0, 0, 0, 0}), false);
+	now = ofGetElapsedTimef();
+	collection.animateTo(3, 10, 1);
+	auto item = collection.getAt(0);
+	collection.removeItem(item);
+	collection.removeIndices(std::vector<size_t>({0}));
+	collection.updateAnimations(now + 2);
+	check(collection.getAt(1)->get() == 10 && collection.getAt(0)->get() == 0, "float",
+		  "removeItem and removeIndices keep the tweens on their items", 2);
+
+	// A tween left running across a clear must not write into the new items
+	now = ofGetElapsedTimef();
+	collection.animateTo(1, 10, 1);
+	collection.clear(false);
+	collection.setCollection(std::vector<float>({0, 0, 0}), false);
+	collection.updateAnimations(now + 2);
+	check(!collection.isAnimating() && collection.getAt(1)->get() == 0, "float", "clear drops the animations", 3);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testStats() {
+#ifdef OFX_PARAMETER_COLLECTION_STATS
+	ofParameterGroup root;
+	ofxParameterCollection<int> collection;
+	collection.setup("Item ", "Collection", root);
+	auto changedListener = collection.collectionChangedEvent.newListener([](ofxParameterCollection<int>&) {});
+	auto itemListener = collection.collectionItemChangedEvent.newListener([](ofParameter<int>&) {});
+
+	fill(collection, {1, 2, 3, 4});
+	collection.getAt(0)->set(5);
+	collection.removeAt(1);
+	collection.setCollection(std::vector<int>({1, 2}));
+	collection.sort();
+	auto& stats = collection.getStats();
+	check(stats.itemsCreated == 6 && stats.itemsDestroyed == 4, "int", "stats count the items", 4);
+	check(stats.itemChangedEvents == 1 && stats.collectionChangedEvents == 2, "int", "stats count the events", 4);
+	check(stats.listenerInvocations == 3, "int", "stats count the listener invocations", 4);
+	check(stats.rebuilds == 1, "int", "stats count the rebuilds", 4);
+
+	collection.resetStats();
+	check(collection.getStats().itemsCreated == 0 && collection.getStats().listenerInvocations == 0, "int",
+		  "resetStats", 2);
+#endif
+}
+
+//--------------------------------------------------------------
+void Benchmark::testTrace() {
+#ifdef OFX_PARAMETER_COLLECTION_TRACING
+	auto& trace = ofxParameterCollectionTrace::get();
+	trace.clear();
+	ofParameterGroup root;
+	ofxParameterCollection<int> collection;
+	collection.setup("Item ", "Collection", root);
+	fill(collection, {1, 2, 3});
+
+	const std::string path = ofToDataPath("benchmark-trace.json");
+	check(trace.dump(path), "int", "trace dump", 3);
+	std::string json = readText(path);
+	check(json.find("\"name\":\"addItem\"") != std::string::npos, "int", "the trace records addItem", 3);
+
+	// Spans from a long session: the timestamps must keep their precision, and a full buffer keeps the newest
+	trace.clear();
+	const uint64_t hour = 3600ull * 1000 * 1000 * 1000;
+	const size_t count = trace.getCapacity() + 10;
+	for (size_t i = 0; i < count; i++) {
+		trace.record("span", hour + i * 1000, hour + i * 1000 + 500);
+	}
+	check(trace.getNumDropped() == 10, "int", "the trace counts the overwritten spans", count);
+	check(trace.dump(path), "int", "trace dump", count);
+	json = readText(path);
+	check(json.find("e+") == std::string::npos, "int", "trace times are not in scientific notation", count);
+	check(json.find("\"ts\":3600000000.000,") == std::string::npos
+		  && json.find("\"ts\":3600000010.000,\"dur\":0.500") != std::string::npos
+		  && json.find("\"ts\":" + ofToString(3600000000ull + count - 1) + ".000,") != std::string::npos, "int",
+		  "the trace keeps the newest spans, in microseconds", count);
+	trace.clear();
+	std::remove(path.c_str());
+#endif
+}
+
+//--------------------------------------------------------------
+void Benchmark::testReloadValues() {
+	ofParameterGroup root;
+	ofxParameterCollection<int> collection;
+	collection.setup("Item ", "Collection", root);
+	fill(collection, {1, 2, 3, 4});
+	ofXml xml;
+	ofSerialize(xml, root);
+
+	fill(collection, {1, 9, 3, 4});
+	std::vector<std::string> events;
+	std::vector<size_t> changed;
+	auto valuesListener = collection.collectionValuesChangedEvent.newListener([&](ofxParameterCollection<int>& c) {
+		events.push_back("values");
+		changed = c.getChangedIndices();
+	});
+	auto changedListener = collection.collectionChangedEvent.newListener([&](ofxParameterCollection<int>&) {
+		events.push_back("changed");
+	});
+	size_t count = collection.reloadValues(xml);
+	check(valuesOf(collection) == std::vector<int>({1, 2, 3, 4}), "int", "reloadValues loads the values", 4);
+	check(count == 1 && changed == std::vector<size_t>({1}), "int", "reloadValues reports the changed items", 4);
+	check(events == std::vector<std::string>({"values"}), "int", "reloadValues only notifies the values", 4);
+	check(collection.reloadValues(xml) == 0, "int", "reloading the same values changes nothing", 4);
+
+	fill(collection, {1, 2});
+	events.clear();
+	collection.reloadValues(xml);
+	check(valuesOf(collection) == std::vector<int>({1, 2, 3, 4}), "int", "reloadValues resizes the collection", 4);
+	check(events == std::vector<std::string>({"changed", "values"}) && changed == std::vector<size_t>({2, 3}), "int",
+		  "reloadValues notifies the resize before the values", 4);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testSpatialIndex() {
+	ofParameterGroup root;
+	ofxParameterCollection<glm::vec2> collection;
+	collection.setup("Item ", "Collection", root);
+	SpatialIndexProbe index;
+	index.setup(collection, 10);
+
+	for (int i = 0; i < 10; i++) {
+		collection.addItem(glm::vec2(i * 10, 0));
+	}
+	check(index.nearest(glm::vec2(31, 2)) == 3, "glm::vec2", "nearest after addItem", 10);
+	check(index.queryRadius(glm::vec2(50, 0), 15).size() == 3, "glm::vec2", "queryRadius", 10);
+	check(index.queryRect(glm::vec2(0, -1), glm::vec2(25, 1)).size() == 3, "glm::vec2", "queryRect", 10);
+
+	collection.getAt(3)->set(glm::vec2(500, 500));
+	check(index.nearest(glm::vec2(499, 499)) == 3, "glm::vec2", "the index follows value changes", 10);
+
+	std::vector<size_t> changed;
+	auto listener = collection.collectionValuesChangedEvent.newListener([&](ofxParameterCollection<glm::vec2>& c) {
+		changed = c.getChangedIndices();
+	});
+	collection.setValuesAt({5, 2}, {glm::vec2(200, 0), glm::vec2(300, 0)});
+	check(changed == std::vector<size_t>({2, 5}), "glm::vec2", "setValuesAt reports the written items", 10);
+	check(index.nearest(glm::vec2(301, 0)) == 2, "glm::vec2", "the index follows setValuesAt", 10);
+
+	collection.animateTo(4, glm::vec2(400, 0), 1);
+	collection.updateAnimations(ofGetElapsedTimef() + 2);
+	check(changed == std::vector<size_t>({4}), "glm::vec2", "updateAnimations reports the animated items", 10);
+	check(index.nearest(glm::vec2(399, 0)) == 4, "glm::vec2", "the index follows the animations", 10);
+
+	collection.getAt(3)->set(glm::vec2(30, 0));
+	check(index.getMaxCell(0) == 40 && index.getMaxCell(1) == 0, "glm::vec2", "the bounds shrink after a change",
+		  10);
+
+	collection.removeIf([](const glm::vec2& value) { return value.x < 20 || value.x >= 300; });
+	check(index.nearest(glm::vec2(31, 0)) == 0 && index.nearest(glm::vec2(61, 0)) == 2, "glm::vec2",
+		  "the index renumbers items after removeIf", 6);
+	check(index.getMaxCell(0) == 20, "glm::vec2", "the bounds shrink after removeIf", 6);
+
+	collection.sort([](const glm::vec2& a, const glm::vec2& b) { return a.x > b.x; });
+	check(index.nearest(glm::vec2(201, 0)) == 0 && index.nearest(glm::vec2(21, 0)) == 5, "glm::vec2",
+		  "the index follows sort", 6);
+	check(index.nearest(glm::vec2(0, 1000), 10) == -1, "glm::vec2", "nearest respects maxDistance", 6);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testRecorder() {
+	ofParameterGroup root;
+	ofxParameterCollection<float> collection;
+	collection.setup("Item ", "Collection", root);
+	collection.setCollection(std::vector<float>({0, 0, 0}), false);
+
+	ofxParameterCollectionRecorder<float> recorder;
+	recorder.setup(collection, 2);
+	recorder.start();
+	collection.getAt(0)->set(1);
+	collection.getAt(1)->set(2);
+	collection.getAt(2)->set(3);
+	recorder.stop();
+	check(recorder.size() == 2 && recorder.getNumDropped() == 1, "float", "the recorder keeps the newest events", 3);
+
+	const std::string path = ofToDataPath("benchmark-recording.bin");
+	check(recorder.save(path), "float", "recorder save", 3);
+	std::vector<ofxParameterCollectionRecordedEvent<float>> events;
+	check(ofxParameterCollectionRecorder<float>::load(path, events) && events.size() == 2 && events[1].index == 2
+		  && events[1].value == 3, "float", "recorder load", 3);
+
+	collection.setCollection(std::vector<float>({0, 0, 0}), false);
+	ofxParameterCollectionPlayer<float> player;
+	player.setup(collection);
+	check(player.load(path), "float", "player load", 3);
+	player.play();
+	player.advanceTo(std::numeric_limits<uint64_t>::max());
+	check(collection.getAt(0)->get() == 0 && collection.getAt(1)->get() == 2 && collection.getAt(2)->get() == 3,
+		  "float", "playback writes the recorded values", 3);
+	check(!player.isPlaying(), "float", "playback stops at the end", 3);
+	std::remove(path.c_str());
+
+	// Batch writes: the reported items, or every item when the batch doesn't report them
+	ofxParameterCollectionRecorder<float> batchRecorder;
+	batchRecorder.setup(collection, 10);
+	batchRecorder.start();
+	collection.setValuesAt({2}, {7});
+	collection.add(1);
+	batchRecorder.stop();
+	auto recorded = batchRecorder.getEvents();
+	check(recorded.size() == 4 && recorded[0].index == 2 && recorded[0].value == 7 && recorded[3].index == 2
+		  && recorded[3].value == 8, "float", "the recorder captures batch writes", 3);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testMemoryUsage() {
+	ofParameterGroup root;
+	ofxParameterCollection<int> collection;
+	collection.setup("Item ", "Collection", root);
+	auto empty = collection.memoryUsage();
+	fill(collection, std::vector<int>(100, 1));
+	auto full = collection.memoryUsage();
+	check(full.items > empty.items && full.controlBlocks > 0 && full.listeners > 0, "int",
+		  "memoryUsage measures the items", 100);
+
+	// A removed item stays allocated while something else holds it
+	auto held = collection.getAt(99);
+	collection.clear(false);
+	check(collection.memoryUsage().controlBlocks > 0, "int", "memoryUsage counts the removed items still held", 100);
+	held.reset();
+	check(collection.memoryUsage().controlBlocks == 0, "int", "memoryUsage drops the items freed by clear", 100);
+
+	// The public container types are the standard ones
+	static_assert(std::is_same<decltype(collection.begin()),
+			std::vector<std::shared_ptr<ofParameter<int>>>::iterator>::value, "begin returns a vector iterator");
+	fill(collection, {1, 2});
+	std::vector<std::shared_ptr<ofParameter<int>>> parameters = collection.getParameters();
+	check(collection.removeItem(collection.begin()) && parameters.size() == 2 && collection.size() == 1, "int",
+		  "removeItem takes a vector iterator", 2);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testFixedCollection() {
+	ofParameterGroup root;
+	ofxFixedParameterCollection<float, 4> collection;
+	collection.setup("Item ", "Fixed", root);
+
+	for (int i = 0; i < 4; i++) {
+		collection.addItem(i);
+	}
+	check(!collection.addItem(4), "float", "a full fixed collection rejects items", 4);
+	check(collection.size() == 4 && collection.getGroup().size() == 4, "float", "fixed addItem", 4);
+
+	size_t changedEvents = 0;
+	size_t itemEvents = 0;
+	auto changedListener = collection.collectionChangedEvent.newListener([&](ofxFixedParameterCollection<float, 4>&) {
+		changedEvents++;
+	});
+	auto itemListener = collection.collectionItemChangedEvent.newListener([&](ofParameter<float>&) {
+		itemEvents++;
+	});
+	collection.removeAt(1);
+	check(collection.size() == 3 && collection.getAt(1)->get() == 2, "float", "fixed removeAt shifts the items", 3);
+	check(changedEvents == 1 && itemEvents == 0, "float", "fixed removeAt notifies once", 3);
+	check(collection.indexOf(collection.getAt(2)) == 2, "float", "fixed indexOf", 3);
+
+	auto item = collection.getAt(0);
+	check(item.use_count() == 0 && std::weak_ptr<ofParameter<float>>(item).expired(), "float",
+		  "fixed items are not owned by their shared_ptrs", 3);
+
+	collection.setCollection(std::vector<float>({5, 6, 7}), false);
+	ofXml xml;
+	ofSerialize(xml, root);
+	collection.setCollection(std::vector<float>({0, 0}), false);
+	collection.preDeserialize(xml);
+	ofDeserialize(xml, root);
+	auto values = collection.getValuesView();
+	check(values.size() == 3 && values[0] == 5 && values[2] == 7, "float", "fixed serialization round trip", 3);
+
+	// A file written in the compact layout by an ofxParameterCollection with the same group name
+	for (auto format : {ofxParameterCollection<float>::SerializationFormat::CompactText,
+						ofxParameterCollection<float>::SerializationFormat::CompactBinary}) {
+		ofParameterGroup otherRoot;
+		ofxParameterCollection<float> other;
+		other.setup("Item ", "Fixed", otherRoot);
+		other.setCollection(std::vector<float>({1, 2, 3, 4, 5}), false);
+		other.setSerializationFormat(format);
+		ofXml compactXml;
+		other.serialize(compactXml);
+
+		size_t valueEvents = 0;
+		auto valuesListener = collection.collectionValuesChangedEvent.newListener(
+			[&](ofxFixedParameterCollection<float, 4>&) {
+				valueEvents++;
+			});
+		collection.preDeserialize(compactXml);
+		values = collection.getValuesView();
+		check(values.size() == 4 && values[0] == 1 && values[3] == 4 && valueEvents == 1, "float",
+			  "fixed preDeserialize loads the compact layout", 4);
+	}
+}
+
+//--------------------------------------------------------------
+void Benchmark::testCodec() {
+	int number = 0;
+	glm::vec2 vector;
+	check(ofxParameterCollectionCodec<int>::parse(" 42\n", number) && number == 42, "int", "codec parse", 1);
+	check(!ofxParameterCollectionCodec<int>::parse("1.5, 2", number), "int", "codec parse rejects trailing text", 1);
+	check(!ofxParameterCollectionCodec<glm::vec2>::parse("1, 2, 3", vector), "glm::vec2",
+		  "codec parse rejects extra components", 1);
+	check(!ofxParameterCollectionCodec<glm::vec2>::parse("1", vector), "glm::vec2",
+		  "codec parse rejects missing components", 1);
+
+	// The compact text layout, with a count that doesn't match its payload
+	ofParameterGroup root;
+	ofxParameterCollection<int> collection;
+	collection.setup("Item ", "Collection", root);
+	ofXml xml;
+	auto group = xml.appendChild("Collection");
+	group.setAttribute("encoding", std::string("csv"));
+	group.setAttribute("count", 2);
+	group.set(std::string("1, 2, 3"));
+	check(collection.deserialize(xml) && valuesOf(collection) == std::vector<int>({1, 2}), "int",
+		  "compact text ignores the values past its count", 2);
+	group.setAttribute("count", 4);
+	check(!collection.deserialize(xml) && valuesOf(collection) == std::vector<int>({1, 2}), "int",
+		  "compact text rejects a payload shorter than its count", 2);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testBulkOperations() {
+	ofParameterGroup root;
+	ofxParameterCollection<float> collection;
+	collection.setup("Item ", "Collection", root, 0.f, 100.f);
+	collection.setCollection(std::vector<float>({0, 10, 20}), false);
+
+	size_t valueEvents = 0;
+	size_t itemEvents = 0;
+	auto valuesListener = collection.collectionValuesChangedEvent.newListener([&](ofxParameterCollection<float>&) {
+		valueEvents++;
+	});
+	auto itemListener = collection.collectionItemChangedEvent.newListener([&](ofParameter<float>&) {
+		itemEvents++;
+	});
+
+	collection.add(5);
+	check(collection.getValuesView()[0] == 5 && collection.getValuesView()[2] == 25, "float", "add", 3);
+	collection.scale(2);
+	check(collection.getValuesView()[0] == 10 && collection.getValuesView()[2] == 50, "float", "scale", 3);
+	collection.lerpTowards(0, 0.5f);
+	check(collection.getValuesView()[1] == 15 && collection.getValuesView()[2] == 25, "float", "lerpTowards", 3);
+	collection.lerpTowards(std::vector<float>({1, 2, 3}), 1);
+	check(collection.getValuesView()[0] == 1 && collection.getValuesView()[2] == 3, "float",
+		  "lerpTowards a value per item", 3);
+	check(valueEvents == 4 && itemEvents == 0, "float", "bulk operations notify once each, without item events", 3);
+
+	collection.add(1, false);
+	check(valueEvents == 4 && collection.getValuesView()[0] == 2, "float", "bulk operations can skip the event", 3);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testPresets() {
+	using Policy = ofxParameterCollection<float>::PresetMismatchPolicy;
+	ofParameterGroup root;
+	ofxParameterCollection<float> collection;
+	collection.setup("Item ", "Collection", root);
+	collection.setCollection(std::vector<float>({0, 0, 0}), false);
+	collection.storePreset("a");
+	collection.setCollection(std::vector<float>({10, 20, 30, 40}), false);
+	collection.storePreset("b");
+
+	check(collection.hasPreset("a") && collection.getPresetNames().size() == 2, "float", "storePreset", 4);
+	check(collection.recallPreset("a") && collection.size() == 3, "float", "recallPreset restores the item count", 3);
+
+	collection.interpolate("a", "b", 0.5f, Policy::Intersect);
+	check(collection.size() == 3 && collection.getAt(1)->get() == 10, "float",
+		  "interpolate keeps the item count with Intersect", 3);
+	collection.interpolate("a", "b", 0.5f, Policy::Resize);
+	check(collection.size() == 4 && collection.getAt(1)->get() == 10 && collection.getAt(3)->get() == 40, "float",
+		  "interpolate blends the presets", 4);
+	check(!collection.recallPreset("missing"), "float", "recallPreset rejects unknown presets", 4);
+	check(collection.removePreset("a") && !collection.hasPreset("a"), "float", "removePreset", 4);
+}
+
+//--------------------------------------------------------------
+void Benchmark::testParallel() {
+	ofParameterGroup root;
+	ofxParameterCollection<int> collection;
+	collection.setup("Item ", "Collection", root);
+	std::vector<int> values(5000);
+	std::iota(values.begin(), values.end(), 0);
+	collection.setCollection(values, false);
+
+	size_t valueEvents = 0;
+	auto listener = collection.collectionValuesChangedEvent.newListener([&](ofxParameterCollection<int>&) {
+		valueEvents++;
+	});
+
+	// A small grain spreads the items over every thread of the pool
+	collection.parallelTransform([](int value) { return value * 2; }, true, 64);
+	auto view = collection.getValuesView();
+	bool doubled = view.size() == values.size();
+	for (size_t i = 0; doubled && i < view.size(); i++) {
+		doubled = view[i] == int(i) * 2;
+	}
+	check(doubled && valueEvents == 1, "int", "parallelTransform", values.size());
+
+	std::vector<int> seen(values.size(), -1);
+	std::atomic<size_t> calls(0);
+	collection.parallelForEach([&](size_t index, const int& value) {
+		seen[index] = value;
+		calls++;
+	}, 64);
+	bool visited = calls == values.size();
+	for (size_t i = 0; visited && i < seen.size(); i++) {
+		visited = seen[i] == int(i) * 2;
+	}
+	check(visited && valueEvents == 1, "int", "parallelForEach visits every item once", values.size());
+}
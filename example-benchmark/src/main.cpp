@@ -0,0 +1,18 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main(int argc, char* argv[])
+{
+	// The largest collection size to benchmark can be passed as the first argument, ex: ./example-benchmark 10000
+	// Pass --test instead to run the checks on small collections without timing them.
+	size_t maxSize = 1000000;
+	bool test = argc > 1 && std::string(argv[1]) == "--test";
+	if (argc > 1 && !test) maxSize = std::stoull(argv[1]);
+
+	// No window or GL context is created, so the benchmark can run on headless machines
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window, 1024, 768, OF_WINDOW);
+	return ofRunApp(new ofApp(maxSize, test));
+}
@@ -0,0 +1,11 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+ofApp::ofApp(size_t maxSize, bool test) : benchmark(maxSize), test(test) {
+}
+
+//--------------------------------------------------------------
+void ofApp::setup() {
+	int failures = test ? benchmark.runTests() : benchmark.run();
+	ofExit(failures > 0 ? 1 : 0);
+}
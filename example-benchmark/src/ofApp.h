@@ -0,0 +1,15 @@
+#pragma once
+
+#include "ofMain.h"
+#include "Benchmark.h"
+
+// Runs the benchmark, or the tests, from setup and exits with the number of failed checks as the status.
+class ofApp : public ofBaseApp {
+
+public:
+	ofApp(size_t maxSize, bool test);
+	void setup();
+
+	Benchmark benchmark;
+	bool test;
+};
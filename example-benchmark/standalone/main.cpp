@@ -0,0 +1,25 @@
+#include "Benchmark.h"
+#include <iostream>
+
+// Entry point of the standalone build (see CMakeLists.txt), which links only the parts of OF that the addon uses
+// and so has no app, window or main loop.
+
+// The recorder and player timestamp events with the frame number, which comes from the main loop. Without one
+// the frame number stays at 0.
+uint64_t ofGetFrameNum()
+{
+	return 0;
+}
+
+//========================================================================
+int main(int argc, char* argv[])
+{
+	// Same arguments as the openFrameworks app: the largest size to benchmark, or --test
+	size_t maxSize = 1000000;
+	bool test = argc > 1 && std::string(argv[1]) == "--test";
+	if (argc > 1 && !test) maxSize = std::stoull(argv[1]);
+
+	Benchmark benchmark(maxSize);
+	int failures = test ? benchmark.runTests() : benchmark.run();
+	return failures > 0 ? 1 : 0;
+}
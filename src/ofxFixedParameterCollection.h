@@ -0,0 +1,522 @@
+#ifndef OFX_FIXED_PARAMETER_COLLECTION_H
+#define OFX_FIXED_PARAMETER_COLLECTION_H
+
+#include "ofxParameterCollection.h"
+#include <array>
+
+/**
+ * @brief ofxFixedParameterCollection is a variant of ofxParameterCollection for collections with a known upper
+ * bound on the number of items (i.e. 64 DMX channels, 128 voices). It serializes exactly like an
+ * ofxParameterCollection with the same prefix and group name, so the two can read each other's files.
+ *
+ * All of the ofParameters, their names and their value listeners are created up front, and stored inline in the
+ * class. Adding an item activates the next free slot and removing an item shifts the values of the following
+ * items down by one, so neither creates nor destroys ofParameters.
+ *
+ * It shares the container API of ofxParameterCollection: setup, setLimits, addItem, emplaceItem, getAt, back,
+ * removeAt, removeItem, indexOf, setCollection, setValues, setValuesAt, begin/end, size, clear, getParameters,
+ * getParametersView, getValuesView, getGroup, preDeserialize (with PreDeserializeMode) and the
+ * collectionChangedEvent, collectionItemChangedEvent and collectionValuesChangedEvent, with the same signatures.
+ * It reads every layout that ofxParameterCollection writes, including the compact ones.
+ *
+ * WARNING: the items are handed out as shared_ptrs that alias the inline ofParameters without owning them (they are
+ * made with the aliasing constructor and an empty owner, so handing them out doesn't allocate). This has three
+ * consequences that don't apply to ofxParameterCollection:
+ * - They are only valid as long as the collection is. Holding one doesn't keep its ofParameter alive.
+ * - use_count() always returns 0.
+ * - A weak_ptr made from one is expired from the start, so lock() returns an empty shared_ptr.
+ *
+ * The other differences are:
+ * - addItem returns false when the collection is full.
+ * - The collectionChangedEvent and collectionValuesChangedEvent pass an ofxFixedParameterCollection.
+ * - The bulk operations, presets, animations, reordering, batch removal, positional serialization and binary
+ * values are only available in ofxParameterCollection.
+ *
+ * @tparam ParameterType: The data type that the ofParameters will wrap.
+ * @tparam Capacity: The maximum number of items in the collection.
+ */
+template<typename ParameterType, size_t Capacity>
+class ofxFixedParameterCollection
+{
+protected:
+	std::string itemPrefix;
+	ofParameterGroup parameterGroup;
+	bool isSetup = false;
+	std::array<ofParameter<ParameterType>, Capacity> storage;
+	// Non-owning shared_ptrs to storage, so that the API matches ofxParameterCollection without allocating
+	std::array<std::shared_ptr<ofParameter<ParameterType>>, Capacity> parameters;
+	std::array<ofEventListener, Capacity> valueListeners;
+	// Scratch storage for getValuesView
+	std::array<ParameterType, Capacity> packedValues;
+	size_t count = 0;
+
+public:
+	using PreDeserializeMode = typename ofxParameterCollection<ParameterType>::PreDeserializeMode;
+
+	/**
+	 * @brief Subscribe to this event to be notified when items are added or removed from the collection.
+	 * The event handler signature should be (ofxFixedParameterCollection<yourCollectionType, Capacity>& pCollection)
+	 */
+	ofEvent<ofxFixedParameterCollection<ParameterType, Capacity>> collectionChangedEvent;
+
+	/**
+	 * @brief Subscribe to this event to be notified when the value of an ofParameter in the collection changes.
+	 * The event handler signature should be (ofParameter<yourCollectionType>& param)
+	 */
+	ofEvent<ofParameter<ParameterType>> collectionItemChangedEvent;
+
+	/**
+	 * @brief Subscribe to this event to be notified once after setValuesAt changed the values of the items.
+	 * The event handler signature should be (ofxFixedParameterCollection<yourCollectionType, Capacity>& pCollection)
+	 */
+	ofEvent<ofxFixedParameterCollection<ParameterType, Capacity>> collectionValuesChangedEvent;
+
+	/**
+	 * @brief Readies the collection for use. Call this method prior to any other in the class. This is where
+	 * the names and listeners of all Capacity items are created.
+	 * @param itemPrefix The std::string that will be prefixed to all of the entries in the collection's
+	 * ofParameterGroup.
+	 * @param groupName The name that will be assigned to the collection's ofParameterGroup.
+	 * @param parentGroup The group where the collection's parameterGroup will be placed in.
+	 */
+	void setup(std::string itemPrefix, std::string groupName, ofParameterGroup& parentGroup)
+	{
+		this->itemPrefix = itemPrefix;
+		for (size_t i = 0; i < Capacity; i++)
+		{
+			auto& param = storage[i];
+			param.setName(itemPrefix + ofToString(i));
+			// The aliasing constructor with an empty owner doesn't allocate a control block. See the class
+			// documentation for what that means to the users of these shared_ptrs.
+			parameters[i] = std::shared_ptr<ofParameter<ParameterType>>(std::shared_ptr<void>(), &param);
+			valueListeners[i] = param.newListener([this, &param](ParameterType&)
+												  {
+													  collectionItemChangedEvent.notify(param);
+												  });
+		}
+		parameterGroup.setName(groupName);
+		parentGroup.add(parameterGroup);
+		isSetup = true;
+	}
+
+	/**
+	 * @brief Readies the collection for use, setting the minimum and maximum for the ofParameters' values.
+	 */
+	void setup(std::string itemPrefix, std::string groupName, ofParameterGroup& parentGroup, ParameterType min,
+			   ParameterType max)
+	{
+		setup(itemPrefix, groupName, parentGroup);
+		setLimits(min, max);
+	}
+
+	/**
+	 * @brief Sets the minimum and maximum for the ofParameters' values.
+	 */
+	void setLimits(ParameterType min, ParameterType max)
+	{
+		for (auto& param : storage)
+		{
+			param.setMin(min);
+			param.setMax(max);
+		}
+	}
+
+	/**
+	 * @brief Returns the maximum number of items in the collection.
+	 */
+	static constexpr size_t capacity()
+	{
+		return Capacity;
+	}
+
+	/**
+	 * @brief Activates the next free ofParameter with the supplied value.
+	 * @param notify If true, notifies the collectionChangedEvent listeners. This is the default behavior.
+	 * @return false if the collection is full.
+	 */
+	bool addItem(const ParameterType& value, bool notify = true)
+	{
+		assert(isSetup);
+		if (count == Capacity)
+		{
+			ofLogNotice("ofxFixedParameterCollection") << "addItem: The collection is full. Capacity: " << Capacity;
+			return false;
+		}
+
+		storage[count].setWithoutEventNotifications(value);
+		parameterGroup.add(storage[count]);
+		count++;
+		assert(count == parameterGroup.size());
+		if (notify) this->notify();
+		return true;
+	}
+
+	/**
+	 * @brief Constructs a value from args and adds it to the collection. Always notifies the
+	 * collectionChangedEvent listeners.
+	 * @return false if the collection is full.
+	 */
+	template<typename... Args>
+	bool emplaceItem(Args&& ... args)
+	{
+		const ParameterType value(std::forward<Args>(args)...);
+		return addItem(value);
+	}
+
+	/**
+	 * @brief Gets the ofParameter at the given index.
+	 */
+	std::shared_ptr<ofParameter<ParameterType>> getAt(int index)
+	{
+		assert(index >= 0 && size_t(index) < count);
+		return parameters[index];
+	}
+
+	/**
+	 * @brief Removes the item at index. The values of the following items are moved down by one, and the last
+	 * ofParameter is deactivated.
+	 * @param notify If true, fires the collectionChangedEvent once. Like in ofxParameterCollection, the items
+	 * that received the value of the next one don't fire their own events. This is the default behavior.
+	 */
+	bool removeAt(int i, bool notify = true)
+	{
+		if (i < 0 || size_t(i) >= count)
+		{
+			ofLogNotice("ofxFixedParameterCollection") << "removeAt: Index out of bounds. Index: " << i;
+			return false;
+		}
+
+		for (size_t j = i; j + 1 < count; j++)
+		{
+			storage[j].setWithoutEventNotifications(storage[j + 1].get());
+		}
+		count--;
+		parameterGroup.remove(count);
+		if (notify) this->notify();
+		return true;
+	}
+
+	/**
+	 * @brief Removes the item. Finding the item is O(1) since it is stored inline.
+	 */
+	bool removeItem(std::shared_ptr<ofParameter<ParameterType>> param, bool notify = true)
+	{
+		int index = indexOf(param);
+		if (index < 0) return false;
+		return removeAt(index, notify);
+	}
+
+	/**
+	 * @brief Returns the position of param in the collection, or -1 if it is not in the collection.
+	 */
+	int indexOf(const std::shared_ptr<ofParameter<ParameterType>>& param) const
+	{
+		return param ? indexOf(*param) : -1;
+	}
+
+	int indexOf(const ofParameter<ParameterType>& param) const
+	{
+		if (&param < storage.data() || &param >= storage.data() + count) return -1;
+		return int(&param - storage.data());
+	}
+
+	/**
+	 * @brief Sets the number of items and their values from the values of the supplied ofParameters, which are
+	 * not added to the collection themselves. Values past the capacity of the collection are ignored.
+	 */
+	void setCollection(std::vector<std::shared_ptr<ofParameter<ParameterType>>> newCollection, bool notify = true)
+	{
+		fill(newCollection.size(), [&](size_t i) -> const ParameterType&
+		{
+			return newCollection[i]->get();
+		});
+		if (notify) this->notify();
+	}
+
+	/**
+	 * @brief Sets the number of items and their values from the supplied values. Values past the capacity of
+	 * the collection are ignored.
+	 */
+	void setCollection(const std::vector<std::shared_ptr<ParameterType>>& newCollection, bool notify = true)
+	{
+		fill(newCollection.size(), [&](size_t i) -> const ParameterType&
+		{
+			return *newCollection[i];
+		});
+		if (notify) this->notify();
+	}
+
+	/**
+	 * @brief Sets the number of items and their values from the supplied vector. Values past the capacity of
+	 * the collection are ignored.
+	 */
+	void setCollection(const std::vector<ParameterType>& newCollection, bool notify = true)
+	{
+		fill(newCollection.size(), [&](size_t i) -> const ParameterType&
+		{
+			return newCollection[i];
+		});
+		if (notify) this->notify();
+	}
+
+	/**
+	 * @brief Sets the values of the ofParameters in the collection. The newValues size() must be
+	 * equal to the number of ofParameters currently in the collection.
+	 */
+	void setValues(const std::vector<std::shared_ptr<ParameterType>>& newValues, bool notify = true)
+	{
+		assert(newValues.size() == count);
+		for (size_t i = 0; i < std::min(count, newValues.size()); i++)
+		{
+			storage[i].set(*newValues[i]);
+		}
+		if (notify) this->notify();
+	}
+
+	/**
+	 * @brief Sets the values of the ofParameters in the collection. The newValues size() must be
+	 * equal to the number of ofParameters currently in the collection.
+	 */
+	void setValues(const std::vector<ParameterType>& newValues, bool notify = true)
+	{
+		setValues(ofxParameterCollectionSpan<const ParameterType>(newValues), notify);
+	}
+
+	/**
+	 * @brief Sets the values of the ofParameters in the collection from any contiguous storage. The newValues
+	 * size() must be equal to the number of ofParameters currently in the collection.
+	 */
+	void setValues(ofxParameterCollectionSpan<const ParameterType> newValues, bool notify = true)
+	{
+		assert(newValues.size() == count);
+		for (size_t i = 0; i < std::min(count, newValues.size()); i++)
+		{
+			storage[i].set(newValues[i]);
+		}
+		if (notify) this->notify();
+	}
+
+	/**
+	 * @brief Sets the values of the items at the supplied indices without firing their individual events,
+	 * and then fires the collectionValuesChangedEvent once. indices and values must have the same size().
+	 * Indices that are out of bounds are ignored.
+	 * @param notify If true, fires the collectionValuesChangedEvent. This is the default behavior.
+	 */
+	void setValuesAt(const std::vector<size_t>& indices, const std::vector<ParameterType>& values, bool notify = true)
+	{
+		assert(indices.size() == values.size());
+		for (size_t i = 0; i < std::min(indices.size(), values.size()); i++)
+		{
+			if (indices[i] < count) storage[indices[i]].setWithoutEventNotifications(values[i]);
+		}
+		if (notify) collectionValuesChangedEvent.notify(*this);
+	}
+
+	/**
+	 * @brief Begin iterator for the ofParameters in the collection.
+	 */
+	typename std::array<std::shared_ptr<ofParameter<ParameterType>>, Capacity>::iterator begin()
+	{
+		return parameters.begin();
+	}
+
+	/**
+	 * @brief End iterator for the ofParameters in the collection.
+	 */
+	typename std::array<std::shared_ptr<ofParameter<ParameterType>>, Capacity>::iterator end()
+	{
+		return parameters.begin() + count;
+	}
+
+	/**
+	 * @brief Returns the number of ofParameters in the collection.
+	 */
+	size_t size()
+	{
+		assert(count == parameterGroup.size());
+		return count;
+	}
+
+	/**
+	 * @brief Returns a reference to the last ofParameter in the collection.
+	 */
+	std::shared_ptr<ofParameter<ParameterType>>& back()
+	{
+		assert(count > 0);
+		return parameters[count - 1];
+	}
+
+	/**
+	 * @brief Returns a copy of the (non-owning) shared_ptrs of the items. Prefer getParametersView, which doesn't
+	 * allocate.
+	 */
+	std::vector<std::shared_ptr<ofParameter<ParameterType>>> getParameters()
+	{
+		return std::vector<std::shared_ptr<ofParameter<ParameterType>>>(parameters.begin(), parameters.begin() + count);
+	}
+
+	/**
+	 * @brief Returns a view over the items, see ofxParameterCollection::getParametersView.
+	 */
+	ofxParameterCollectionSpan<const std::shared_ptr<ofParameter<ParameterType>>> getParametersView() const
+	{
+		return ofxParameterCollectionSpan<const std::shared_ptr<ofParameter<ParameterType>>>(parameters.data(), count);
+	}
+
+	/**
+	 * @brief Returns a view over a packed snapshot of the values of the items, see
+	 * ofxParameterCollection::getValuesView.
+	 */
+	ofxParameterCollectionSpan<const ParameterType> getValuesView()
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			packedValues[i] = storage[i].get();
+		}
+		return ofxParameterCollectionSpan<const ParameterType>(packedValues.data(), count);
+	}
+
+	/**
+	 * @brief Removes all items from the collection.
+	 */
+	void clear(bool notify = true)
+	{
+		resize(0);
+		if (notify) this->notify();
+	}
+
+	/**
+	 * @brief Gets you the ofParameterGroup that includes the ofParameters in the collection. Do not add or remove
+	 * items from the ofParameterGroup yourself.
+	 */
+	ofParameterGroup& getGroup()
+	{
+		assert(isSetup);
+		return parameterGroup;
+	}
+
+	/**
+	 * @brief Call this method prior to deserializing the collection, see ofxParameterCollection::preDeserialize.
+	 * Items beyond the capacity of the collection are ignored.
+	 */
+	void preDeserialize(ofXml& xml, bool clear = true)
+	{
+		preDeserialize(xml, clear ? PreDeserializeMode::Clear : PreDeserializeMode::Append);
+	}
+
+	/**
+	 * @brief Call this method prior to deserializing the collection, see ofxParameterCollection::preDeserialize.
+	 * Items beyond the capacity of the collection are ignored. If the group was written in one of the compact
+	 * layouts, the values are loaded here instead of by ofDeserialize, and the collectionValuesChangedEvent fires
+	 * once for all of them.
+	 * @param mode What to do with the items already in the collection.
+	 */
+	void preDeserialize(ofXml& xml, PreDeserializeMode mode)
+	{
+		assert(isSetup);
+
+		if (mode == PreDeserializeMode::Clear) resize(0);
+
+		auto path = "//" + parameterGroup.getEscapedName();
+		auto search = xml.findFirst(path);
+		if (!search)
+		{
+			ofLogNotice(__FUNCTION__) << "Could not find " << path;
+			return;
+		}
+
+		if (search.getAttribute("encoding"))
+		{
+			// The compact layout has no elements for ofDeserialize to match, so the values are loaded right away
+			std::vector<ParameterType> values;
+			if (!ofxParameterCollection<ParameterType>::decodeCompact(
+					search, parameterGroup.getName(), values,
+					std::integral_constant<bool, ofxParameterCollectionTraits<ParameterType>::isPacked>()))
+			{
+				return;
+			}
+			const size_t first = mode == PreDeserializeMode::Append ? count : 0;
+			if (first + values.size() > Capacity)
+			{
+				ofLogError(__FUNCTION__) << "Group " << parameterGroup.getName() << " has " << first + values.size()
+										 << " items, only the first " << Capacity << " will be loaded";
+			}
+			const size_t loaded = std::min(values.size(), Capacity - first);
+			resize(first + loaded);
+			for (size_t i = 0; i < loaded; i++)
+			{
+				storage[first + i].setWithoutEventNotifications(values[i]);
+			}
+			// ofDeserialize won't fire the item events for these values, so the listeners hear about them here
+			collectionValuesChangedEvent.notify(*this);
+			return;
+		}
+
+		size_t entries = mode == PreDeserializeMode::Append ? count : 0;
+		for (auto child : search.getChildren())
+		{
+			if (child.getValue().size() == 0)
+			{
+				ofLogError(__FUNCTION__) << "Ignoring empty child in group " << parameterGroup.getName();
+				continue;
+			}
+			entries++;
+		}
+		if (entries > Capacity)
+		{
+			ofLogError(__FUNCTION__) << "Group " << parameterGroup.getName() << " has " << entries
+									 << " items, only the first " << Capacity << " will be loaded";
+		}
+		resize(std::min(entries, Capacity));
+	}
+
+	/**
+	 * @brief Notifies the listeners of the collectionChangedEvent.
+	 */
+	void notify()
+	{
+		collectionChangedEvent.notify(*this);
+	}
+
+protected:
+	/**
+	 * @brief Sets the number of items to newCount, or to the capacity if it is smaller, and writes value(i) to
+	 * each item without firing its events.
+	 */
+	template<typename Value>
+	void fill(size_t newCount, Value value)
+	{
+		if (newCount > Capacity)
+		{
+			ofLogNotice("ofxFixedParameterCollection") << "setCollection: " << newCount
+													   << " values don't fit in a collection of capacity " << Capacity;
+		}
+		resize(std::min(newCount, Capacity));
+		for (size_t i = 0; i < count; i++)
+		{
+			storage[i].setWithoutEventNotifications(value(i));
+		}
+	}
+
+	/**
+	 * @brief Activates or deactivates ofParameters at the end of the collection until it holds newCount items.
+	 * Newly activated items get a default constructed value.
+	 */
+	void resize(size_t newCount)
+	{
+		assert(newCount <= Capacity);
+		while (count > newCount)
+		{
+			count--;
+			parameterGroup.remove(count);
+		}
+		while (count < newCount)
+		{
+			storage[count].setWithoutEventNotifications(ParameterType());
+			parameterGroup.add(storage[count]);
+			count++;
+		}
+	}
+};
+
+#endif //OFX_FIXED_PARAMETER_COLLECTION_H
@@ -6,6 +6,138 @@
 #define OFX_PARAMETER_COLLECTION_H
 
 #include <ofParameter.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include "ofxParameterCollectionAllocator.h"
+#include "ofxParameterCollectionCodec.h"
+#include "ofxParameterCollectionThreadPool.h"
+#include "ofxParameterCollectionTrace.h"
+
+#ifdef OFX_PARAMETER_COLLECTION_STATS
+#define OFX_PC_STATS(statement) statement
+#else
+#define OFX_PC_STATS(statement)
+#endif
+
+/**
+ * @brief A non-owning view over a contiguous sequence of values, like C++20's std::span. It is only valid for as
+ * long as the storage it was created from is alive and not resized, so don't keep it around: create it, use it
+ * and let it go out of scope.
+ */
+template<typename T>
+class ofxParameterCollectionSpan
+{
+	T* first = nullptr;
+	size_t count = 0;
+
+public:
+	ofxParameterCollectionSpan() = default;
+
+	ofxParameterCollectionSpan(T* data, size_t size) : first(data), count(size)
+	{}
+
+	template<typename Allocator>
+	ofxParameterCollectionSpan(std::vector<typename std::remove_const<T>::type, Allocator>& vector) :
+			first(vector.data()), count(vector.size())
+	{}
+
+	template<typename Allocator>
+	ofxParameterCollectionSpan(const std::vector<typename std::remove_const<T>::type, Allocator>& vector) :
+			first(vector.data()), count(vector.size())
+	{}
+
+	template<size_t N>
+	ofxParameterCollectionSpan(T (& array)[N]) : first(array), count(N)
+	{}
+
+	T* data() const { return first; }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	T* begin() const { return first; }
+	T* end() const { return first + count; }
+	T& operator[](size_t index) const { return first[index]; }
+};
+
+/**
+ * @brief Compile-time properties of the types stored in an ofxParameterCollection.
+ *
+ * isPacked is true for trivially copyable types (numbers, glm vectors, ofColor, etc). Their values can be copied
+ * as raw memory and written to binary streams as is. ValueArg is how the collection takes single values as
+ * arguments: small packed types by value, everything else (i.e. std::string) by const reference to avoid a copy.
+ */
+template<typename ParameterType>
+struct ofxParameterCollectionTraits
+{
+	static constexpr bool isPacked = std::is_trivially_copyable<ParameterType>::value;
+	using ValueArg = typename std::conditional<isPacked && sizeof(ParameterType) <= 4 * sizeof(float),
+											   ParameterType, const ParameterType&>::type;
+};
+
+/**
+ * @brief A run of consecutive item indices, see ofxParameterCollection::getRemovedRanges.
+ */
+struct ofxParameterCollectionRange
+{
+	size_t begin = 0;
+	size_t count = 0;
+};
+
+/**
+ * @brief Operation counters of an ofxParameterCollection, see ofxParameterCollection::getStats.
+ * Times are in microseconds.
+ */
+struct ofxParameterCollectionStats
+{
+	uint64_t itemsCreated = 0;
+	uint64_t itemsDestroyed = 0;
+	uint64_t rebuilds = 0; // Times the whole collection was re-created by setCollection
+	uint64_t collectionChangedEvents = 0;
+	uint64_t itemChangedEvents = 0;
+	uint64_t valuesChangedEvents = 0;
+	uint64_t reorderedEvents = 0;
+	uint64_t listenerInvocations = 0; // Calls to listeners of the four events above
+	uint64_t preDeserializeTime = 0;
+	uint64_t setCollectionTime = 0;
+};
+
+/**
+ * @brief Bytes used by an ofxParameterCollection, see ofxParameterCollection::memoryUsage. The first four fields
+ * are measured, the last three are estimates of the storage that OF allocates for each item.
+ */
+struct ofxParameterCollectionMemoryUsage
+{
+	size_t items = 0; // The ofParameter handles, the item vector and the index of item positions
+	size_t controlBlocks = 0; // shared_ptr control blocks of the items, and removed items still held elsewhere
+	size_t listeners = 0; // The vector of per-item value listeners
+	size_t mirrors = 0; // Packed value buffers, presets and animations
+	size_t parameterInternals = 0; // Estimate: the value, limits and event that each ofParameter shares
+	size_t names = 0; // Estimate: heap storage of the item names in the ofParameters and the group
+	size_t groupEntries = 0; // Estimate: entries in the collection's ofParameterGroup
+
+	size_t total() const
+	{
+		return items + controlBlocks + listeners + mirrors + parameterInternals + names + groupEntries;
+	}
+};
+
+/**
+ * @brief Adds the time between its construction and destruction to target.
+ */
+struct ofxParameterCollectionStatsTimer
+{
+	uint64_t& target;
+	uint64_t start;
+
+	ofxParameterCollectionStatsTimer(uint64_t& target) : target(target), start(ofGetElapsedTimeMicros())
+	{}
+
+	~ofxParameterCollectionStatsTimer()
+	{
+		target += ofGetElapsedTimeMicros() - start;
+	}
+};
 
 /**
  * @brief ofxParameterCollection allows you to have an indefinite number of ofParameters of the same type while
@@ -23,17 +155,131 @@
 template<typename ParameterType>
 class ofxParameterCollection
 {
+	// Reads the compact layout through decodeCompact
+	template<typename, size_t> friend class ofxFixedParameterCollection;
+
 protected:
 	std::string itemPrefix;
 	ofParameterGroup parameterGroup;
+	// The group passed to setup, used by serialize to place the collection when it isn't in the XML yet.
+	ofParameterGroup parent;
 	bool isSetup = false;
 	bool hasLimits = false;
+	// The items and the containers below allocate through these, so that memoryUsage can report what they
+	// actually use. The item vector keeps the standard allocator, since its type is part of the public API.
+	std::shared_ptr<ofxParameterCollectionAllocationCounters> allocationCounters =
+			std::make_shared<ofxParameterCollectionAllocationCounters>();
+
+	template<typename T>
+	ofxParameterCollectionAllocator<T> countingAllocator(size_t ofxParameterCollectionAllocationCounters::* counter) const
+	{
+		return ofxParameterCollectionAllocator<T>(allocationCounters, counter);
+	}
+
 	std::vector<std::shared_ptr<ofParameter<ParameterType>>> parameters;
-	ofEventListeners valueListeners;
+	// Position of each item in parameters, so that indexOf and removeItem don't have to search for it.
+	using IndexMap = std::unordered_map<const ofParameter<ParameterType>*, size_t,
+			std::hash<const ofParameter<ParameterType>*>, std::equal_to<const ofParameter<ParameterType>*>,
+			ofxParameterCollectionAllocator<std::pair<const ofParameter<ParameterType>* const, size_t>>>;
+	IndexMap parameterIndices = IndexMap(0, typename IndexMap::hasher(), typename IndexMap::key_equal(),
+										 countingAllocator<typename IndexMap::value_type>(
+												 &ofxParameterCollectionAllocationCounters::items));
+	using ListenerVector = std::vector<ofEventListener, ofxParameterCollectionAllocator<ofEventListener>>;
+	ListenerVector valueListeners = ListenerVector(
+			countingAllocator<ofEventListener>(&ofxParameterCollectionAllocationCounters::listeners));
 	ParameterType min;
 	ParameterType max;
+	// Scratch storage used by the bulk operations. Values are packed contiguously so that the arithmetic
+	// loops can be auto-vectorized by the compiler. Kept as a member to avoid reallocating on every call.
+	std::vector<ParameterType> packedValues;
+	using PresetMap = std::map<std::string, std::vector<ParameterType>, std::less<std::string>,
+			ofxParameterCollectionAllocator<std::pair<const std::string, std::vector<ParameterType>>>>;
+	PresetMap presets = PresetMap(std::less<std::string>(), countingAllocator<typename PresetMap::value_type>(
+			&ofxParameterCollectionAllocationCounters::presets));
+	ofxParameterCollectionStats stats;
+	// Sorted indices of the items being removed by removeIf and removeIndices, and the same indices grouped into
+	// ranges for the listeners.
+	std::vector<size_t> removedIndices;
+	std::vector<ofxParameterCollectionRange> removedRanges;
+	// The item appended by addItem, for the listeners of the collectionChangedEvent.
+	ofxParameterCollectionRange addedRange;
+	// The order applied by the last move, swap or sort: permutation[newIndex] == oldIndex.
+	std::vector<size_t> permutation;
+	// Indices of the items written by reloadValues, for the listeners of the collectionValuesChangedEvent.
+	std::vector<size_t> changedIndices;
+	bool parallelParsing = false;
+public:
+
+	/**
+	 * @brief How serialize writes the collection.
+	 * Items: One XML element per item, the layout ofSerialize uses.
+	 * CompactText: A single element with a count attribute, holding all of the values as comma separated numbers.
+	 * CompactBinary: A single element with a count attribute, holding the raw bytes of the values as base64. The
+	 * values are stored exactly, but the data is not portable between platforms with different endianness.
+	 */
+	enum class SerializationFormat
+	{
+		Items,
+		CompactText,
+		CompactBinary
+	};
+
+protected:
+	SerializationFormat serializationFormat = SerializationFormat::Items;
+	static constexpr uint32_t cacheMagic = 0x4343504f; // "OPCC"
+	static constexpr uint32_t cacheVersion = 1;
+public:
+
+	/**
+	 * @brief Easing curves available to animateTo.
+	 */
+	enum class Easing
+	{
+		Linear,
+		QuadIn,
+		QuadOut,
+		QuadInOut,
+		CubicIn,
+		CubicOut,
+		CubicInOut,
+		SineInOut
+	};
+
+protected:
+	// Active tweens, stored as parallel arrays so that updateAnimations can process each field in a tight loop.
+	struct Tweens
+	{
+		std::vector<size_t> indices;
+		std::vector<ParameterType> from;
+		std::vector<ParameterType> to;
+		std::vector<float> startTimes;
+		std::vector<float> durations;
+		std::vector<Easing> easings;
+		std::vector<uint8_t> started;
+		std::vector<float> progress;
+		std::vector<float> eased;
+	} tweens;
+	std::vector<size_t> animatedIndices;
+	std::vector<ParameterType> animatedValues;
+	// For each item, the position in animatedValues of the value updateAnimations last wrote to it during the
+	// current update, or SIZE_MAX. Every entry is SIZE_MAX between updates.
+	std::vector<size_t> animatedSlots;
 public:
 
+	/**
+	 * @brief Determines what interpolate does when the two presets (or the collection) have a different number
+	 * of items.
+	 * Intersect: Only the items present in both presets are blended, the rest are left untouched.
+	 * HoldLonger: Items present in only one of the presets take that preset's value.
+	 * Resize: Like HoldLonger, but the collection is first resized to the item count of the longer preset.
+	 */
+	enum class PresetMismatchPolicy
+	{
+		Intersect,
+		HoldLonger,
+		Resize
+	};
+
 	/**
 	 * @brief Subscribe to this event to be notified when items are added or removed from the collection.
 	 * The event handler signature should be (ofxParameterCollection<yourCollectionType>& pCollection)
@@ -59,6 +305,23 @@ public:
 
 	ofEvent<ofParameter<ParameterType>> collectionItemChangedEvent;
 
+	/**
+	 * @brief Subscribe to this event to be notified when the values of many items change at once, as is the case
+	 * with the bulk operations (transform, add, scale, lerpTowards). Bulk operations do not fire the
+	 * collectionItemChangedEvent for each item, they fire this event once after all of the values were written.
+	 * reloadValues, setValuesAt and updateAnimations fire it too, and getChangedIndices tells you which items they
+	 * changed. When a load or a preset also resizes the collection, the collectionChangedEvent fires first.
+	 * The event handler signature should be (ofxParameterCollection<yourCollectionType>& pCollection)
+	 */
+	ofEvent<ofxParameterCollection<ParameterType>> collectionValuesChangedEvent;
+
+	/**
+	 * @brief Subscribe to this event to be notified when move, swap or sort reorder the items. During the
+	 * notification, getPermutation tells you where each item came from.
+	 * The event handler signature should be (ofxParameterCollection<yourCollectionType>& pCollection)
+	 */
+	ofEvent<ofxParameterCollection<ParameterType>> collectionReorderedEvent;
+
 	/**
 	 * @brief Readies the collection for use. Call this method prior to any other in the class.
 	 * @param itemPrefix The std::string that will be prefixed to all of the entries in the collection's
@@ -73,6 +336,7 @@ public:
 		this->itemPrefix = itemPrefix;
 		parameterGroup.setName(groupName);
 		parentGroup.add(parameterGroup);
+		parent = parentGroup;
 		isSetup = true;
 	}
 
@@ -109,8 +373,9 @@ public:
 	 * @param value The value that the ofParameter will be assigned.
 	 * @param notify If true, notifies the collectionChangedEvent listeners. This is the default behavior.
 	 */
-	void addItem(ParameterType value, bool notify = true)
+	void addItem(typename ofxParameterCollectionTraits<ParameterType>::ValueArg value, bool notify = true)
 	{
+		OFX_PC_TRACE_SCOPE("addItem");
 		assert(isSetup);
 		ofParameter<ParameterType> param;
 		param.set(itemPrefix + ofToString(parameterGroup.size()),
@@ -122,17 +387,41 @@ public:
 			param.setMax(max);
 		}
 
-		auto paramPtr = std::make_shared<ofParameter<ParameterType>>(param);
+		auto paramPtr = std::allocate_shared<ofParameter<ParameterType>>(countingAllocator<ofParameter<ParameterType>>(
+				&ofxParameterCollectionAllocationCounters::itemBlocks), param);
 
-		valueListeners.push(paramPtr->newListener([&, paramPtr](ParameterType& value)
+		valueListeners.push_back(paramPtr->newListener([&, paramPtr](ParameterType&)
 												  {
+													  OFX_PC_TRACE_SCOPE("collectionItemChangedEvent");
+													  OFX_PC_STATS(stats.itemChangedEvents++);
+													  OFX_PC_STATS(
+															  stats.listenerInvocations += collectionItemChangedEvent.size());
 													  collectionItemChangedEvent.notify(*paramPtr);
 												  }));
+		OFX_PC_STATS(stats.itemsCreated++);
 
+		parameterIndices[paramPtr.get()] = parameters.size();
 		parameters.push_back(paramPtr);
 		parameterGroup.add(*paramPtr);
 		assert(parameters.size() == parameterGroup.size());
-		if (notify) collectionChangedEvent.notify(*this);
+		if (notify)
+		{
+			addedRange = {parameters.size() - 1, 1};
+			this->notify();
+			addedRange = {};
+		}
+	}
+
+	/**
+	 * @brief Constructs a value from args and adds it to the collection, like std::vector::emplace_back. The
+	 * value is constructed once and copied straight into the new ofParameter. Always notifies the
+	 * collectionChangedEvent listeners.
+	 */
+	template<typename... Args>
+	void emplaceItem(Args&& ... args)
+	{
+		const ParameterType value(std::forward<Args>(args)...);
+		addItem(value);
 	}
 
 	// TODO
@@ -150,7 +439,7 @@ public:
 	
 	bool removeAt(int i, bool notify = true)
 	{
-		if (i >= parameters.size())
+		if (i < 0 || size_t(i) >= parameters.size())
 		{
 			ofLogNotice("ofxParameterCollection") << "removeAt: Index out of bounds. Index: " << i;
 			return false;
@@ -161,29 +450,219 @@ public:
 
 	bool removeItem(std::shared_ptr<ofParameter<ParameterType>> param, bool notify = true)
 	{
-		auto iter = std::find(parameters.begin(), parameters.end(), param);
-		return removeItem(iter, notify);
+		int index = indexOf(param);
+		if (index < 0) return false;
+		return removeItem(parameters.begin() + index, notify);
+	}
+
+	/**
+	 * @brief Returns the position of param in the collection, or -1 if it is not in the collection.
+	 * This is a hash lookup, so it doesn't depend on the size of the collection.
+	 */
+	int indexOf(const std::shared_ptr<ofParameter<ParameterType>>& param) const
+	{
+		return param ? indexOf(*param) : -1;
+	}
+
+	int indexOf(const ofParameter<ParameterType>& param) const
+	{
+		auto found = parameterIndices.find(&param);
+		if (found == parameterIndices.end()) return -1;
+		assert(parameters[found->second].get() == &param);
+		return int(found->second);
+	}
+
+	/**
+	 * @brief Removes the item at iter. Like removeIndices with a single index: the values of the following items
+	 * move down into the existing ofParameters and the last ofParameter is destroyed, so the ofParameters keep
+	 * their positional names. Active animations follow their items.
+	 * @param notify If true, fires the collectionChangedEvent once, see removeIf. This is the default behavior.
+	 */
+	bool removeItem(typename std::vector<std::shared_ptr<ofParameter<ParameterType>>>::iterator iter,
+					bool notify = true)
+	{
+		OFX_PC_TRACE_SCOPE("removeItem");
+		if (iter == parameters.end()) return false;
+		removedIndices.assign(1, size_t(iter - parameters.begin()));
+		return removeSortedIndices(notify) > 0;
 	}
 
-	bool
-	removeItem(typename std::vector<std::shared_ptr<ofParameter<ParameterType>>>::iterator iter, bool notify = true)
+	/**
+	 * @brief Removes every item whose value satisfies predicate, in a single pass. Unlike removeItem, the
+	 * collection is not rebuilt: the values of the remaining items are moved down into the existing ofParameters
+	 * (keeping their order), and only the ofParameters left over at the end are destroyed. This means that an
+	 * ofParameter you hold after the first removed item will now hold the value of a later item, just as its
+	 * name now refers to a different position. Active animations follow their items.
+	 * @param predicate A callable with the signature bool(const ParameterType&).
+	 * @param notify If true, fires the collectionChangedEvent once. During the notification, getRemovedRanges
+	 * tells you which items were removed: the values after the first removed item shifted down by the number of
+	 * items removed before them. The ofParameters that received a new value don't fire their own value events
+	 * (nor the collectionItemChangedEvent), so a removal costs one notification however many items shifted.
+	 * Listeners that mirror the values should re-read them from the first removed index. This is the default
+	 * behavior.
+	 * @return The number of items removed.
+	 */
+	template<typename Predicate>
+	size_t removeIf(Predicate predicate, bool notify = true)
 	{
-		if (iter != parameters.end())
+		removedIndices.clear();
+		for (size_t i = 0; i < parameters.size(); i++)
 		{
-			parameters.erase(iter);
-			// Sadly we can't delete single params from the group and rename them, otherwise
-			// ofParameterGroup loses track of it. So we use setCollection to clear the group
-			// and re-add all our items. On the upside, we leave no dangling event listeners.
-			setCollection(parameters, false);
-			if (notify) collectionChangedEvent.notify(*this);
-			assert(parameterGroup.size() == parameters.size());
-			return true;
+			if (predicate(parameters[i]->get())) removedIndices.push_back(i);
 		}
-		return false;
+		return removeSortedIndices(notify);
+	}
+
+	/**
+	 * @brief Removes the items at the supplied indices in a single pass, see removeIf. The indices can be in any
+	 * order, and duplicates and indices out of bounds are ignored.
+	 * @param notify If true, fires the collectionChangedEvent once, see removeIf. This is the default behavior.
+	 * @return The number of items removed.
+	 */
+	size_t removeIndices(ofxParameterCollectionSpan<const size_t> indices, bool notify = true)
+	{
+		removedIndices.clear();
+		for (auto index : indices)
+		{
+			if (index < parameters.size()) removedIndices.push_back(index);
+		}
+		std::sort(removedIndices.begin(), removedIndices.end());
+		removedIndices.erase(std::unique(removedIndices.begin(), removedIndices.end()), removedIndices.end());
+		return removeSortedIndices(notify);
+	}
+
+	size_t removeIndices(const std::vector<size_t>& indices, bool notify = true)
+	{
+		return removeIndices(ofxParameterCollectionSpan<const size_t>(indices), notify);
+	}
+
+	/**
+	 * @brief Returns the items removed by removeIf or removeIndices, as runs of consecutive indices (in the
+	 * positions they had before the removal), sorted. Only valid inside a collectionChangedEvent handler fired
+	 * by those methods, it is empty otherwise.
+	 */
+	const std::vector<ofxParameterCollectionRange>& getRemovedRanges() const
+	{
+		return removedRanges;
+	}
+
+	/**
+	 * @brief Returns the items appended by addItem, which left the other items untouched. Only valid inside a
+	 * collectionChangedEvent handler fired by addItem, its count is 0 otherwise.
+	 */
+	const ofxParameterCollectionRange& getAddedRange() const
+	{
+		return addedRange;
+	}
+
+	/**
+	 * @brief Moves the item at index from to index to, shifting the items in between by one, like erasing it
+	 * and inserting it again. The items are reordered by moving their values between the existing ofParameters,
+	 * which keep their positional names, so nothing is created or destroyed and only the items between from and
+	 * to are written. Active animations follow their items.
+	 * @param notify If true, fires the collectionReorderedEvent once. During the notification getPermutation tells
+	 * you where each item came from. The ofParameters that received a new value don't fire their own value events
+	 * (nor the collectionItemChangedEvent), so listeners that mirror the values should read them through the
+	 * permutation. This is the default behavior.
+	 * @return false if either index is out of bounds.
+	 */
+	bool move(size_t from, size_t to, bool notify = true)
+	{
+		if (from >= parameters.size() || to >= parameters.size())
+		{
+			ofLogNotice("ofxParameterCollection") << "move: Index out of bounds. From: " << from << " To: " << to;
+			return false;
+		}
+		if (from == to) return true;
+
+		resetPermutation();
+		const ParameterType moved = parameters[from]->get();
+		if (from < to)
+		{
+			for (size_t i = from; i < to; i++)
+			{
+				parameters[i]->setWithoutEventNotifications(parameters[i + 1]->get());
+			}
+			std::rotate(permutation.begin() + from, permutation.begin() + from + 1, permutation.begin() + to + 1);
+		}
+		else
+		{
+			for (size_t i = from; i > to; i--)
+			{
+				parameters[i]->setWithoutEventNotifications(parameters[i - 1]->get());
+			}
+			std::rotate(permutation.begin() + to, permutation.begin() + from, permutation.begin() + from + 1);
+		}
+		parameters[to]->setWithoutEventNotifications(moved);
+		applyPermutationToTweens();
+		if (notify) notifyReordered();
+		return true;
+	}
+
+	/**
+	 * @brief Swaps the values of the items at indices a and b, see move.
+	 * @param notify If true, fires the collectionReorderedEvent once, see move. This is the default behavior.
+	 * @return false if either index is out of bounds.
+	 */
+	bool swap(size_t a, size_t b, bool notify = true)
+	{
+		if (a >= parameters.size() || b >= parameters.size())
+		{
+			ofLogNotice("ofxParameterCollection") << "swap: Index out of bounds. A: " << a << " B: " << b;
+			return false;
+		}
+		if (a == b) return true;
+
+		resetPermutation();
+		const ParameterType value = parameters[a]->get();
+		parameters[a]->setWithoutEventNotifications(parameters[b]->get());
+		parameters[b]->setWithoutEventNotifications(value);
+		std::swap(permutation[a], permutation[b]);
+		applyPermutationToTweens();
+		if (notify) notifyReordered();
+		return true;
+	}
+
+	/**
+	 * @brief Sorts the items by value, keeping the order of equal items. Only the items that end up in a
+	 * different position are written, see move.
+	 * @param compare A callable with the signature bool(const ParameterType& a, const ParameterType& b) that
+	 * returns true if a goes before b. Defaults to operator<.
+	 * @param notify If true, fires the collectionReorderedEvent once, see move. This is the default behavior.
+	 */
+	template<typename Compare = std::less<ParameterType>>
+	void sort(Compare compare = Compare(), bool notify = true)
+	{
+		OFX_PC_TRACE_SCOPE("sort");
+		packValues();
+		resetPermutation();
+		const ParameterType* values = packedValues.data();
+		std::stable_sort(permutation.begin(), permutation.end(), [values, &compare](size_t a, size_t b)
+		{
+			return compare(values[a], values[b]);
+		});
+		for (size_t i = 0; i < permutation.size(); i++)
+		{
+			if (permutation[i] != i) parameters[i]->setWithoutEventNotifications(values[permutation[i]]);
+		}
+		applyPermutationToTweens();
+		if (notify) notifyReordered();
+	}
+
+	/**
+	 * @brief Returns the order applied by the last move, swap or sort, as the previous index of the item now at
+	 * each index. Only meaningful inside a collectionReorderedEvent handler.
+	 */
+	const std::vector<size_t>& getPermutation() const
+	{
+		return permutation;
 	}
 
 	void setCollection(std::vector<std::shared_ptr<ofParameter<ParameterType>>> newCollection, bool notify = true)
 	{
+		OFX_PC_STATS(ofxParameterCollectionStatsTimer timer(stats.setCollectionTime));
+		OFX_PC_STATS(stats.rebuilds++);
+		OFX_PC_TRACE_SCOPE("setCollection");
 		this->clear(false);
 		for (auto& paramPtr : newCollection)
 		{
@@ -200,8 +679,11 @@ public:
 	 * The listeners to the collectionChangedEvent and collectionItemChangedEvent are not affected.
 	 * @param newCollection
 	 */
-	void setCollection(std::vector<std::shared_ptr<ParameterType>> newCollection, bool notify = true)
+	void setCollection(const std::vector<std::shared_ptr<ParameterType>>& newCollection, bool notify = true)
 	{
+		OFX_PC_STATS(ofxParameterCollectionStatsTimer timer(stats.setCollectionTime));
+		OFX_PC_STATS(stats.rebuilds++);
+		OFX_PC_TRACE_SCOPE("setCollection");
 		this->clear(false);
 		for (auto& paramPtr : newCollection)
 		{
@@ -217,8 +699,11 @@ public:
 	 * The listeners to the collectionChangedEvent are not affected.
 	 * @param newCollection
 	 */
-	void setCollection(std::vector<ParameterType> newCollection, bool notify = true)
+	void setCollection(const std::vector<ParameterType>& newCollection, bool notify = true)
 	{
+		OFX_PC_STATS(ofxParameterCollectionStatsTimer timer(stats.setCollectionTime));
+		OFX_PC_STATS(stats.rebuilds++);
+		OFX_PC_TRACE_SCOPE("setCollection");
 		this->clear(false);
 		for (auto& value : newCollection)
 		{
@@ -232,12 +717,12 @@ public:
 	 * equal to the number of ofParameters currently in the collection.
 	 * @param newValues
 	 */
-	void setValues(std::vector<std::shared_ptr<ParameterType>> newValues, bool notify = true)
+	void setValues(const std::vector<std::shared_ptr<ParameterType>>& newValues, bool notify = true)
 	{
 		assert(newValues.size() == parameters.size());
-		for (int i = 0; i < parameters.size(); i++)
+		for (size_t i = 0; i < parameters.size(); i++)
 		{
-			parameters[i].get() = *(newValues[i]);
+			parameters[i]->set(*(newValues[i]));
 		}
 		if (notify) this->notify();
 	}
@@ -247,12 +732,24 @@ public:
 	 * equal to the number of ofParameters currently in the collection.
 	 * @param newValues
 	 */
-	void setValues(std::vector<ParameterType> newValues, bool notify = true)
+	void setValues(const std::vector<ParameterType>& newValues, bool notify = true)
+	{
+		setValues(ofxParameterCollectionSpan<const ParameterType>(newValues), notify);
+	}
+
+	/**
+	 * @brief Sets the values of the ofParameters in the collection from any contiguous storage (a vector, an
+	 * array, or a pointer and a size), without copying it first. The @param newValues size() must be
+	 * equal to the number of ofParameters currently in the collection.
+	 * @param newValues
+	 */
+	void setValues(ofxParameterCollectionSpan<const ParameterType> newValues, bool notify = true)
 	{
 		assert(newValues.size() == parameters.size());
-		for (int i = 0; i < parameters.size(); i++)
+		const size_t count = std::min(newValues.size(), parameters.size());
+		for (size_t i = 0; i < count; i++)
 		{
-			parameters[i].get() = newValues[i];
+			parameters[i]->set(newValues[i]);
 		}
 		if (notify) this->notify();
 	}
@@ -301,6 +798,7 @@ public:
 	 */
 	void clear(bool notify = true)
 	{
+		OFX_PC_TRACE_SCOPE("clear");
 		// I'm not calling parameterGroup.clear() because I was concerned that it would clear
 		// its value pointer and muck up the Parameter tree elsewhere. Testing would clear that up, but
 		// this works for the moment
@@ -308,9 +806,13 @@ public:
 		{
 			parameterGroup.remove(i);
 		}
+		OFX_PC_STATS(stats.itemsDestroyed += parameters.size());
 		parameters.clear();
-		valueListeners.unsubscribeAll();
-		if (notify) collectionChangedEvent.notify(*this);
+		parameterIndices.clear();
+		valueListeners.clear();
+		// The animations refer to items by index, so they would carry over to unrelated new items
+		resizeTweens(0);
+		if (notify) this->notify();
 	}
 
 	/**
@@ -327,6 +829,22 @@ public:
 		return parameterGroup;
 	}
 
+	/**
+	 * @brief Determines what preDeserialize does with the items already in the collection.
+	 * Clear: All items are destroyed, then one item is created for each entry in the XML.
+	 * Append: One item is created for each entry in the XML, after the existing ones.
+	 * Reconcile: The existing items are kept, and items are only created or destroyed at the end of the
+	 * collection to match the number of entries in the XML. Use this when you reload values into a collection
+	 * that is already populated (i.e. recalling a preset file): when the sizes match, nothing is allocated, and
+	 * the listeners you added to the items stay in place.
+	 */
+	enum class PreDeserializeMode
+	{
+		Clear,
+		Append,
+		Reconcile
+	};
+
 	/**
 	 * @brief Call this method prior to deserializing the ofxParameterCollection. IF YOU DON'T CALL THIS METHOD
 	 * DESERIALIZATION WILL NOT WORK! See the example for usage, but the long and short of it is that you should
@@ -347,15 +865,26 @@ public:
 	 * values. You should call ofDeserialize right after preDeserialize to assign values to the created parameters.
 	 */
 	void preDeserialize(ofXml& xml, bool clear = true)
+	{
+		preDeserialize(xml, clear ? PreDeserializeMode::Clear : PreDeserializeMode::Append);
+	}
+
+	/**
+	 * @brief Call this method prior to deserializing the ofxParameterCollection, see preDeserialize(ofXml&, bool).
+	 * If the group was written in one of the compact layouts (see setSerializationFormat), the values are loaded
+	 * here instead of by ofDeserialize, and the collectionValuesChangedEvent fires once for all of them.
+	 * @param xml The XML root from which to start searching for the parameter group.
+	 * @param mode What to do with the items already in the collection.
+	 */
+	void preDeserialize(ofXml& xml, PreDeserializeMode mode)
 	{
 		assert(isSetup);
+		OFX_PC_STATS(ofxParameterCollectionStatsTimer timer(stats.preDeserializeTime));
+		OFX_PC_TRACE_SCOPE("preDeserialize");
 
-		if (clear) this->clear(false); // Don't notify, since we are going to deserialize soon
+		if (mode == PreDeserializeMode::Clear) this->clear(false); // Don't notify, since we are going to deserialize soon
 
-//		auto root = xml.findFirst("//" + parameterGroup.getEscapedName());
 		auto path = "//" + parameterGroup.getEscapedName();
-
-
 		auto search = xml.findFirst(path);
 
 		if (!search)
@@ -363,8 +892,35 @@ public:
 			ofLogNotice(__FUNCTION__) << "Could not find " << path;
 			return;
 		}
-		auto children = search.getChildren();
-		for (auto child : children)
+
+		if (search.getAttribute("encoding"))
+		{
+			// The compact layout has no elements for ofDeserialize to match, so the values are loaded right away
+			if (!decodeCompact(search, parameterGroup.getName(), packedValues,
+							   std::integral_constant<bool, ofxParameterCollectionTraits<ParameterType>::isPacked>()))
+			{
+				return;
+			}
+			const size_t first = mode == PreDeserializeMode::Append ? parameters.size() : 0;
+			if (mode == PreDeserializeMode::Reconcile)
+			{
+				resizeItems(packedValues.size());
+			}
+			else
+			{
+				addEntries(packedValues.size(), false);
+			}
+			for (size_t i = 0; i < packedValues.size(); i++)
+			{
+				parameters[first + i]->setWithoutEventNotifications(packedValues[i]);
+			}
+			// ofDeserialize won't fire the item events for these values, so the listeners hear about them here
+			notifyValuesChanged();
+			return;
+		}
+
+		size_t entries = 0;
+		for (auto child : search.getChildren())
 		{
 			ofLogVerbose(__FUNCTION__) << child.getName();
 			if (child.getValue().size() == 0)
@@ -372,30 +928,1429 @@ public:
 				ofLogError(__FUNCTION__) << "Ignoring empty child in group " << parameterGroup.getName();
 				continue;
 			}
-			addEntry(false);
+			entries++;
+		}
+
+		if (mode == PreDeserializeMode::Reconcile)
+		{
+			resizeItems(entries);
+		}
+		else
+		{
+			addEntries(entries, false);
 		}
 	}
 
 	/**
-	 * @brief Returns a copy of the parameter storage vector. Note that modifying this vector does not change
-	 * the internal state of the collection. If you want to iterate over the collection, consider using the
-	 * begin() and end() iterators of the class, or use a range based for loop.
+	 * @brief Loads the values of the collection from xml without recreating the items, as an alternative to
+	 * preDeserialize followed by ofDeserialize. The values are matched to the items by position, the collection
+	 * is resized to the number of entries in the XML like preDeserialize does in Reconcile mode, and only the items
+	 * whose value differs from the loaded one are written. Reloading a preset where few values changed is cheap,
+	 * and the listeners only hear about what actually changed.
+	 * @param xml The XML root from which to start searching for the parameter group.
+	 * @param notify If true and any value changed, fires the collectionValuesChangedEvent once. During the
+	 * notification getChangedIndices tells you which items changed. If the collection was resized, the
+	 * collectionChangedEvent fires before it. This is the default behavior.
+	 * @return The number of items whose value changed.
 	 */
-	std::vector<std::shared_ptr<ofParameter<ParameterType>>> getParameters()
+	size_t reloadValues(ofXml& xml, bool notify = true)
 	{
-		return parameters;
+		assert(isSetup);
+		OFX_PC_TRACE_SCOPE("reloadValues");
+		if (!decodeValues(xml)) return 0;
+		bool resized = resizeItems(packedValues.size());
+		return applyChangedValues(notify, resized);
 	}
 
 	/**
-	 * @brief Notifies the listeners of the collectionChangedEvent. You shouldn't have to call this yourself
-	 * in most situations.
+	 * @brief Writes the collection to xml, in the same layout ofSerialize uses, so the two can be mixed freely:
+	 * ofDeserialize reads what serialize writes, and deserialize reads what ofSerialize writes. serialize walks the
+	 * items and the XML elements side by side instead of looking up each element by name, and reuses the
+	 * elements that are already there, so saving again into the same ofXml is cheap.
+	 *
+	 * ofSerialize(xml, mainGroup) keeps working as before. To save and load large collections through these
+	 * methods only, call getGroup().setSerializable(false) once, so that ofSerialize and ofDeserialize skip the
+	 * collection, and call serialize or deserialize right after them.
+	 * @param xml The XML root where the parameter group is searched for. If it isn't there, it is created
+	 * inside the element of the group passed to setup, or inside xml if that isn't there either.
 	 */
-	void notify()
+	void serialize(ofXml& xml)
 	{
-		collectionChangedEvent.notify(*this);
+		assert(isSetup);
+		OFX_PC_TRACE_SCOPE("serialize");
+
+		auto groupXml = xml.findFirst("//" + parameterGroup.getEscapedName());
+		if (!groupXml)
+		{
+			auto parentName = parent.getEscapedName();
+			auto parentXml = xml.getName() == parentName ? xml : xml.findFirst("//" + parentName);
+			groupXml = (parentXml ? parentXml : xml).appendChild(parameterGroup.getEscapedName());
+		}
+
+		if (serializationFormat != SerializationFormat::Items && ofxParameterCollectionTraits<ParameterType>::isPacked)
+		{
+			writeCompact(groupXml, std::integral_constant<bool, ofxParameterCollectionTraits<ParameterType>::isPacked>());
+			return;
+		}
+		if (groupXml.getAttribute("encoding"))
+		{
+			// Written in the compact layout before. Its text is removed along with any other unexpected children.
+			groupXml.removeAttribute("encoding");
+			groupXml.removeAttribute("count");
+		}
+
+		std::string text;
+		auto child = groupXml.getFirstChild();
+		size_t i = 0;
+		for (; i < parameters.size() && child; i++)
+		{
+			if (child.getName() != parameters[i]->getEscapedName()) break;
+			text.clear();
+			ofxParameterCollectionCodec<ParameterType>::format(parameters[i]->get(), text);
+			child.set(text);
+			child = child.getNextSibling();
+		}
+		while (child)
+		{
+			auto next = child.getNextSibling();
+			groupXml.removeChild(child);
+			child = next;
+		}
+		for (; i < parameters.size(); i++)
+		{
+			text.clear();
+			ofxParameterCollectionCodec<ParameterType>::format(parameters[i]->get(), text);
+			groupXml.appendChild(parameters[i]->getEscapedName()).set(text);
+		}
+	}
+
+	/**
+	 * @brief Loads the collection from xml, as a replacement for preDeserialize followed by ofDeserialize. The
+	 * values are assigned by position instead of matching each element by name, the collection is resized like
+	 * preDeserialize does in Reconcile mode, and the values are written without firing the
+	 * collectionItemChangedEvent for each item.
+	 * @param xml The XML root from which to start searching for the parameter group.
+	 * @param notify If true, fires the collectionValuesChangedEvent once, and the collectionChangedEvent if the
+	 * collection was resized. This is the default behavior.
+	 * @return false if the parameter group was not found in xml, in which case the collection is left untouched.
+	 */
+	bool deserialize(ofXml& xml, bool notify = true)
+	{
+		assert(isSetup);
+		OFX_PC_TRACE_SCOPE("deserialize");
+		if (!decodeValues(xml)) return false;
+		bool resized = resizeItems(packedValues.size());
+		applyPackedValues(notify, resized);
+		return true;
+	}
+
+	/**
+	 * @brief Loads the collection from the XML file at xmlPath like deserialize does, keeping a binary copy of the
+	 * values in a cache file next to it (see getCachePath). The cache is keyed by the size and a hash of the XML
+	 * file, so as long as the XML file doesn't change, later calls read the values from the cache without parsing
+	 * the XML. Hashing the file is much cheaper than parsing it. The modification time isn't part of the key: it
+	 * changes when the file is copied or checked out without its contents changing, and it doesn't always change
+	 * when the file is rewritten quickly.
+	 *
+	 * The cache is only available for trivially copyable types (numbers, glm vectors, ofColor). For other types
+	 * the XML file is parsed every time.
+	 * @param notify If true, fires the collectionValuesChangedEvent once, and the collectionChangedEvent if the
+	 * collection was resized. This is the default behavior.
+	 * @return false if the XML file could not be loaded or doesn't contain the collection, in which case the
+	 * collection is left untouched.
+	 */
+	bool loadCached(const std::string& xmlPath, bool notify = true)
+	{
+		assert(isSetup);
+		OFX_PC_TRACE_SCOPE("loadCached");
+		const std::integral_constant<bool, ofxParameterCollectionTraits<ParameterType>::isPacked> packed{};
+		uint64_t xmlSize = 0;
+		uint64_t xmlHash = 0;
+		if (!hashFile(xmlPath, xmlSize, xmlHash))
+		{
+			ofLogError("ofxParameterCollection") << "loadCached: Could not open " << xmlPath;
+			return false;
+		}
+		if (readCache(getCachePath(xmlPath), xmlSize, xmlHash, notify, packed)) return true;
+
+		ofXml xml;
+		if (!xml.load(xmlPath) || !deserialize(xml, notify)) return false;
+		writeCache(getCachePath(xmlPath), xmlSize, xmlHash, packed);
+		return true;
+	}
+
+	/**
+	 * @brief Returns the path of the cache file used by loadCached for the XML file at xmlPath. Each collection
+	 * has its own cache file, named after its group.
+	 */
+	std::string getCachePath(const std::string& xmlPath) const
+	{
+		return xmlPath + "." + parameterGroup.getEscapedName() + ".cache";
+	}
+
+	/**
+	 * @brief Sets how serialize writes the collection, see SerializationFormat. The loaders (preDeserialize,
+	 * deserialize and reloadValues) recognize every format, so files in the Items layout keep loading after you
+	 * switch to a compact one.
+	 *
+	 * ofSerialize and ofDeserialize only know the Items layout, so selecting a compact format marks the
+	 * collection's group as not serializable, and you save it by calling serialize after ofSerialize. Selecting
+	 * Items makes it serializable again. The compact formats are only available for trivially copyable types
+	 * (numbers, glm vectors, ofColor); other types are always written as Items. CompactText needs a type that
+	 * ofxParameterCollectionCodec can write as numbers, other trivially copyable types are written as CompactBinary.
+	 */
+	void setSerializationFormat(SerializationFormat format)
+	{
+		serializationFormat = format;
+		parameterGroup.setSerializable(format == SerializationFormat::Items);
+	}
+
+	SerializationFormat getSerializationFormat() const
+	{
+		return serializationFormat;
+	}
+
+	/**
+	 * @brief When enabled, deserialize and reloadValues first gather the text of every item from the XML and then
+	 * parse it into values in chunks across the threads of ofxParameterCollectionThreadPool::shared(). The values
+	 * are still written to the items on the calling thread, in one batch. Parsing is the bulk of the work of
+	 * loading large numeric collections, so this pays off with tens of thousands of items; smaller collections
+	 * are parsed on the calling thread anyway. Disabled by default.
+	 */
+	void setParallelParsing(bool parallel)
+	{
+		parallelParsing = parallel;
+	}
+
+	bool isParallelParsing() const
+	{
+		return parallelParsing;
+	}
+
+	/**
+	 * @brief Returns the indices of the items whose value changed, in increasing order. Only valid inside a
+	 * collectionValuesChangedEvent handler fired by reloadValues, setValuesAt or updateAnimations. The other bulk
+	 * operations write every item, and for them it is empty.
+	 */
+	const std::vector<size_t>& getChangedIndices() const
+	{
+		return changedIndices;
+	}
+
+	/**
+	 * @brief Returns a copy of the parameter storage vector. Note that modifying this vector does not change
+	 * the internal state of the collection. If you want to iterate over the collection, consider using the
+	 * begin() and end() iterators of the class, a range based for loop, or getParametersView, none of which
+	 * copy the vector.
+	 */
+	std::vector<std::shared_ptr<ofParameter<ParameterType>>> getParameters()
+	{
+		return parameters;
+	}
+
+	/**
+	 * @brief Returns a view over the parameter storage, without copying the vector or touching the shared_ptr
+	 * reference counts. Prefer this over getParameters when you read the parameters every frame.
+	 * The view is invalidated by anything that adds or removes items, so don't store it.
+	 */
+	ofxParameterCollectionSpan<const std::shared_ptr<ofParameter<ParameterType>>> getParametersView() const
+	{
+		return ofxParameterCollectionSpan<const std::shared_ptr<ofParameter<ParameterType>>>(parameters);
+	}
+
+	/**
+	 * @brief Returns a view over the current values of the items, packed contiguously. The values are gathered
+	 * into a buffer owned by the collection, which is reused between calls, so this does not allocate once the
+	 * buffer is large enough. The view is a snapshot: it does not reflect later changes to the items, and it is
+	 * invalidated by the next call to getValuesView, by the bulk operations, and by anything that adds or
+	 * removes items.
+	 */
+	ofxParameterCollectionSpan<const ParameterType> getValuesView()
+	{
+		packValues();
+		return ofxParameterCollectionSpan<const ParameterType>(packedValues);
+	}
+
+	/**
+	 * @brief Notifies the listeners of the collectionChangedEvent. You shouldn't have to call this yourself
+	 * in most situations.
+	 */
+	void notify()
+	{
+		OFX_PC_TRACE_SCOPE("collectionChangedEvent");
+		OFX_PC_STATS(stats.collectionChangedEvents++);
+		OFX_PC_STATS(stats.listenerInvocations += collectionChangedEvent.size());
+		collectionChangedEvent.notify(*this);
+	}
+
+	/**
+	 * @brief Returns the operation counters of the collection. The counters are only updated when the addon is
+	 * compiled with OFX_PARAMETER_COLLECTION_STATS defined (i.e. add -DOFX_PARAMETER_COLLECTION_STATS to your
+	 * compiler flags), otherwise they stay at zero.
+	 */
+	const ofxParameterCollectionStats& getStats() const
+	{
+		return stats;
+	}
+
+	/**
+	 * @brief Sets all of the operation counters back to zero.
+	 */
+	void resetStats()
+	{
+		stats = ofxParameterCollectionStats();
+	}
+
+	/**
+	 * @brief Returns the number of bytes used by the collection, broken down by category. Everything the
+	 * collection allocates itself is measured exactly: the items and their control blocks, the index of item
+	 * positions, the listener vector and the presets are counted by their allocator, and the item vector, the
+	 * value buffers and the animations from the capacity of their vectors. An item stays allocated for as long as
+	 * a shared_ptr to it exists, so items that were removed from the collection but are still held by your code
+	 * are counted in controlBlocks until you release them. What OF allocates inside each ofParameter and in
+	 * the ofParameterGroup can't be seen from here, so parameterInternals, names and groupEntries are estimated
+	 * from the size of those types, without allocator overhead.
+	 * This walks every item, so it is O(n).
+	 */
+	ofxParameterCollectionMemoryUsage memoryUsage() const
+	{
+		ofxParameterCollectionMemoryUsage usage;
+		const size_t count = parameters.size();
+		const auto& counters = *allocationCounters;
+
+		// allocate_shared puts the ofParameter handle and its control block in one allocation
+		const size_t handles = count * sizeof(ofParameter<ParameterType>);
+		usage.items = handles + parameters.capacity() * sizeof(std::shared_ptr<ofParameter<ParameterType>>)
+					  + counters.items;
+		usage.controlBlocks = counters.itemBlocks > handles ? counters.itemBlocks - handles : 0;
+		usage.listeners = counters.listeners;
+
+		usage.mirrors = counters.presets + packedValues.capacity() * sizeof(ParameterType);
+		for (auto& value : packedValues)
+		{
+			usage.mirrors += heapSize(value);
+		}
+		for (auto& preset : presets)
+		{
+			usage.mirrors += heapSize(preset.first) + preset.second.capacity() * sizeof(ParameterType);
+			for (auto& value : preset.second)
+			{
+				usage.mirrors += heapSize(value);
+			}
+		}
+		usage.mirrors += tweens.indices.capacity() * sizeof(size_t)
+						 + (tweens.from.capacity() + tweens.to.capacity()) * sizeof(ParameterType)
+						 + (tweens.startTimes.capacity() + tweens.durations.capacity() + tweens.progress.capacity()
+							+ tweens.eased.capacity()) * sizeof(float)
+						 + tweens.easings.capacity() * sizeof(Easing)
+						 + tweens.started.capacity() * sizeof(uint8_t)
+						 + (animatedIndices.capacity() + animatedSlots.capacity()) * sizeof(size_t)
+						 + animatedValues.capacity() * sizeof(ParameterType);
+
+		// Each ofParameter shares a block made by make_shared holding its value, min, max, event and name.
+		const size_t controlBlockSize = 2 * sizeof(long) + sizeof(void*);
+		usage.parameterInternals = count * (controlBlockSize + 3 * sizeof(ParameterType) + sizeof(std::string)
+											+ sizeof(ofEvent<ParameterType>));
+		for (auto& param : parameters)
+		{
+			usage.parameterInternals += heapSize(param->get());
+		}
+		// The names are the prefix followed by the index. Each is stored by the ofParameter and as the key of the
+		// group's index. Computed from the length so that no name has to be copied out of the ofParameters.
+		size_t digits = 1;
+		size_t nextDigit = 10;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (i == nextDigit)
+			{
+				digits++;
+				nextDigit *= 10;
+			}
+			usage.names += 2 * stringHeapSize(itemPrefix.size() + digits);
+		}
+		// The group holds a copy of each ofParameter behind a shared_ptr of its own, and indexes it by name
+		usage.groupEntries = count * (controlBlockSize + sizeof(ofParameter<ParameterType>)
+									  + sizeof(std::shared_ptr<ofAbstractParameter>)
+									  + sizeof(std::pair<std::string, size_t>) + 4 * sizeof(void*));
+		return usage;
+	}
+
+	/**
+	 * @brief Applies function to the value of every item in the collection. The values are processed as a
+	 * packed array and written back without per-item notifications.
+	 * @param function A callable with the signature ParameterType(const ParameterType&).
+	 * @param notify If true, fires the collectionValuesChangedEvent once. This is the default behavior.
+	 */
+	template<typename Function>
+	void transform(Function function, bool notify = true)
+	{
+		packValues();
+		ParameterType* values = packedValues.data();
+		const size_t count = packedValues.size();
+		for (size_t i = 0; i < count; i++)
+		{
+			values[i] = function(values[i]);
+		}
+		applyPackedValues(notify);
+	}
+
+	/**
+	 * @brief Adds delta to the value of every item in the collection. Only usable with types that
+	 * support operator+ (numbers, glm vectors, ofColor, etc).
+	 * @param notify If true, fires the collectionValuesChangedEvent once. This is the default behavior.
+	 */
+	void add(const ParameterType& delta, bool notify = true)
+	{
+		packValues();
+		ParameterType* values = packedValues.data();
+		const size_t count = packedValues.size();
+		for (size_t i = 0; i < count; i++)
+		{
+			values[i] = values[i] + delta;
+		}
+		applyPackedValues(notify);
+	}
+
+	/**
+	 * @brief Multiplies the value of every item in the collection by factor. Only usable with types that
+	 * support multiplication by a float.
+	 * @param notify If true, fires the collectionValuesChangedEvent once. This is the default behavior.
+	 */
+	void scale(float factor, bool notify = true)
+	{
+		packValues();
+		ParameterType* values = packedValues.data();
+		const size_t count = packedValues.size();
+		for (size_t i = 0; i < count; i++)
+		{
+			values[i] = static_cast<ParameterType>(values[i] * factor);
+		}
+		applyPackedValues(notify);
+	}
+
+	/**
+	 * @brief Moves the value of every item in the collection towards target by the normalized amount t.
+	 * A t of 0 leaves the values unchanged, a t of 1 sets them all to target.
+	 * @param notify If true, fires the collectionValuesChangedEvent once. This is the default behavior.
+	 */
+	void lerpTowards(const ParameterType& target, float t, bool notify = true)
+	{
+		packValues();
+		ParameterType* values = packedValues.data();
+		const size_t count = packedValues.size();
+		for (size_t i = 0; i < count; i++)
+		{
+			values[i] = lerpValue(values[i], target, t);
+		}
+		applyPackedValues(notify);
+	}
+
+	/**
+	 * @brief Moves the value of each item in the collection towards its corresponding value in targets by the
+	 * normalized amount t. The targets size() must be equal to the number of items in the collection.
+	 * @param notify If true, fires the collectionValuesChangedEvent once. This is the default behavior.
+	 */
+	void lerpTowards(const std::vector<ParameterType>& targets, float t, bool notify = true)
+	{
+		assert(targets.size() == parameters.size());
+		packValues();
+		ParameterType* values = packedValues.data();
+		const ParameterType* targetValues = targets.data();
+		const size_t count = std::min(packedValues.size(), targets.size());
+		for (size_t i = 0; i < count; i++)
+		{
+			values[i] = lerpValue(values[i], targetValues[i], t);
+		}
+		applyPackedValues(notify);
+	}
+
+	/**
+	 * @brief Like transform, but the values are processed in chunks of grain items across the threads of
+	 * ofxParameterCollectionThreadPool::shared(). The results are written back to the items on the calling thread,
+	 * so listeners are still notified from the thread that called parallelTransform. function is called
+	 * concurrently and must not touch the collection. Collections smaller than grain are processed on the calling
+	 * thread.
+	 * @param function A callable with the signature ParameterType(const ParameterType&).
+	 * @param notify If true, fires the collectionValuesChangedEvent once. This is the default behavior.
+	 */
+	template<typename Function>
+	void parallelTransform(Function function, bool notify = true, size_t grain = 1024)
+	{
+		OFX_PC_TRACE_SCOPE("parallelTransform");
+		packValues();
+		ParameterType* values = packedValues.data();
+		ofxParameterCollectionThreadPool::shared().parallelFor(packedValues.size(), grain,
+															   [values, &function](size_t begin, size_t end)
+															   {
+																   for (size_t i = begin; i < end; i++)
+																   {
+																	   values[i] = function(values[i]);
+																   }
+															   });
+		applyPackedValues(notify);
+	}
+
+	/**
+	 * @brief Calls function with the index and value of every item in the collection, in chunks of grain items
+	 * across the threads of ofxParameterCollectionThreadPool::shared(). The values are read from a snapshot taken
+	 * before the call, so function can't change them and must not touch the collection.
+	 * @param function A callable with the signature void(size_t index, const ParameterType& value).
+	 */
+	template<typename Function>
+	void parallelForEach(Function function, size_t grain = 1024)
+	{
+		OFX_PC_TRACE_SCOPE("parallelForEach");
+		packValues();
+		const ParameterType* values = packedValues.data();
+		ofxParameterCollectionThreadPool::shared().parallelFor(packedValues.size(), grain,
+															   [values, &function](size_t begin, size_t end)
+															   {
+																   for (size_t i = begin; i < end; i++)
+																   {
+																	   function(i, values[i]);
+																   }
+															   });
+	}
+
+	/**
+	 * @brief Stores the current values of the collection as a preset with the supplied name. If a preset with
+	 * that name exists it is overwritten.
+	 */
+	void storePreset(const std::string& name)
+	{
+		auto& values = presets[name];
+		values.resize(parameters.size());
+		for (size_t i = 0; i < parameters.size(); i++)
+		{
+			values[i] = parameters[i]->get();
+		}
+	}
+
+	/**
+	 * @brief Returns true if a preset with the supplied name has been stored.
+	 */
+	bool hasPreset(const std::string& name) const
+	{
+		return presets.find(name) != presets.end();
+	}
+
+	/**
+	 * @brief Removes the preset with the supplied name. Returns false if there is no such preset.
+	 */
+	bool removePreset(const std::string& name)
+	{
+		return presets.erase(name) > 0;
+	}
+
+	/**
+	 * @brief Returns the names of the stored presets, in alphabetical order.
+	 */
+	std::vector<std::string> getPresetNames() const
+	{
+		std::vector<std::string> names;
+		names.reserve(presets.size());
+		for (auto& preset : presets)
+		{
+			names.push_back(preset.first);
+		}
+		return names;
+	}
+
+	/**
+	 * @brief Sets the values of the collection to the ones stored in the preset. If the preset has a different
+	 * number of items than the collection, the collection is resized to match it.
+	 * @param notify If true, fires the collectionValuesChangedEvent, and the collectionChangedEvent if the
+	 * collection was resized. This is the default behavior.
+	 * @return false if there is no preset with that name.
+	 */
+	bool recallPreset(const std::string& name, bool notify = true)
+	{
+		auto preset = presets.find(name);
+		if (preset == presets.end())
+		{
+			ofLogNotice("ofxParameterCollection") << "recallPreset: No preset named " << name;
+			return false;
+		}
+
+		bool resized = resizeItems(preset->second.size());
+		packedValues = preset->second;
+		applyPackedValues(notify, resized);
+		return true;
+	}
+
+	/**
+	 * @brief Writes a blend of two stored presets into the collection. The blend is computed in a single
+	 * pass over the packed preset values, so it is cheap enough to call every frame for morphing.
+	 * @param presetA The name of the preset used when t is 0.
+	 * @param presetB The name of the preset used when t is 1.
+	 * @param t The normalized blend amount.
+	 * @param policy What to do when the presets and the collection have different item counts.
+	 * @param notify If true, fires the collectionValuesChangedEvent, and the collectionChangedEvent if the
+	 * collection was resized. This is the default behavior.
+	 * @return false if either of the presets does not exist.
+	 */
+	bool interpolate(const std::string& presetA, const std::string& presetB, float t,
+					 PresetMismatchPolicy policy = PresetMismatchPolicy::Intersect, bool notify = true)
+	{
+		auto a = presets.find(presetA);
+		auto b = presets.find(presetB);
+		if (a == presets.end() || b == presets.end())
+		{
+			ofLogNotice("ofxParameterCollection") << "interpolate: No preset named "
+												  << (a == presets.end() ? presetA : presetB);
+			return false;
+		}
+
+		const auto& valuesA = a->second;
+		const auto& valuesB = b->second;
+		const size_t shorter = std::min(valuesA.size(), valuesB.size());
+		const size_t longer = std::max(valuesA.size(), valuesB.size());
+
+		bool resized = false;
+		if (policy == PresetMismatchPolicy::Resize) resized = resizeItems(longer);
+
+		// Only the items that won't be overwritten need their current values packed
+		const size_t count = parameters.size();
+		const size_t written = policy == PresetMismatchPolicy::Intersect ? std::min(shorter, count)
+																		  : std::min(longer, count);
+		if (written < count)
+		{
+			packValues();
+		}
+		else
+		{
+			packedValues.resize(count);
+		}
+
+		ParameterType* values = packedValues.data();
+		const ParameterType* dataA = valuesA.data();
+		const ParameterType* dataB = valuesB.data();
+		const size_t blended = std::min(shorter, count);
+		for (size_t i = 0; i < blended; i++)
+		{
+			values[i] = lerpValue(dataA[i], dataB[i], t);
+		}
+
+		if (policy != PresetMismatchPolicy::Intersect)
+		{
+			const auto& longerValues = valuesA.size() > valuesB.size() ? valuesA : valuesB;
+			std::copy(longerValues.begin() + blended, longerValues.begin() + written, packedValues.begin() + blended);
+		}
+
+		applyPackedValues(notify, resized);
+		return true;
+	}
+
+	/**
+	 * @brief Writes the number of items and their values to out as raw bytes. Only available for trivially
+	 * copyable types (numbers, glm vectors, ofColor), whose values are written as a single block. Note that the
+	 * data is not portable between platforms with different endianness.
+	 * @return false if writing failed.
+	 */
+	bool writeValues(std::ostream& out)
+	{
+		static_assert(ofxParameterCollectionTraits<ParameterType>::isPacked,
+					  "writeValues is only available for trivially copyable types");
+		packValues();
+		const uint64_t count = packedValues.size();
+		out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		out.write(reinterpret_cast<const char*>(packedValues.data()), count * sizeof(ParameterType));
+		return out.good();
+	}
+
+	/**
+	 * @brief Reads values written by writeValues, resizing the collection to the number of values read. Only
+	 * available for trivially copyable types.
+	 * @param notify If true, fires the collectionValuesChangedEvent, and the collectionChangedEvent if the
+	 * collection was resized. This is the default behavior.
+	 * @return false if reading failed, in which case the collection is left untouched.
+	 */
+	bool readValues(std::istream& in, bool notify = true)
+	{
+		static_assert(ofxParameterCollectionTraits<ParameterType>::isPacked,
+					  "readValues is only available for trivially copyable types");
+		uint64_t count = 0;
+		in.read(reinterpret_cast<char*>(&count), sizeof(count));
+		if (!in.good()) return false;
+
+		// The values are read in chunks of about 1 MB, so a corrupt count fails when the stream runs out instead
+		// of allocating memory for all of the values up front
+		const uint64_t chunkSize = (1 << 20) / sizeof(ParameterType) + 1;
+		packedValues.clear();
+		while (packedValues.size() < count)
+		{
+			const size_t begin = packedValues.size();
+			const size_t chunk = size_t(std::min<uint64_t>(count - begin, chunkSize));
+			packedValues.resize(begin + chunk);
+			in.read(reinterpret_cast<char*>(packedValues.data() + begin), chunk * sizeof(ParameterType));
+			if (size_t(in.gcount()) != chunk * sizeof(ParameterType)) return false;
+		}
+
+		bool resized = resizeItems(count);
+		applyPackedValues(notify, resized);
+		return true;
+	}
+
+	/**
+	 * @brief Sets the values of the items at the supplied indices without firing their individual events,
+	 * and then fires the collectionValuesChangedEvent once. This is the batch write path used by the animations,
+	 * and it is useful whenever you change many values at once. indices and values must have the same size().
+	 * Indices that are out of bounds are ignored.
+	 * @param notify If true, fires the collectionValuesChangedEvent. During the notification getChangedIndices
+	 * returns the indices that were written. This is the default behavior.
+	 */
+	void setValuesAt(const std::vector<size_t>& indices, const std::vector<ParameterType>& values, bool notify = true)
+	{
+		assert(indices.size() == values.size());
+		const size_t count = std::min(indices.size(), values.size());
+		for (size_t i = 0; i < count; i++)
+		{
+			if (indices[i] < parameters.size()) parameters[indices[i]]->setWithoutEventNotifications(values[i]);
+		}
+		if (!notify) return;
+
+		changedIndices.clear();
+		for (size_t i = 0; i < count; i++)
+		{
+			if (indices[i] < parameters.size()) changedIndices.push_back(indices[i]);
+		}
+		std::sort(changedIndices.begin(), changedIndices.end());
+		changedIndices.erase(std::unique(changedIndices.begin(), changedIndices.end()), changedIndices.end());
+		notifyValuesChanged();
+		changedIndices.clear();
+	}
+
+	/**
+	 * @brief Animates the value of the item at index from its current value to target. The animation starts
+	 * after delay seconds and lasts duration seconds. Animations are advanced by updateAnimations, so make sure
+	 * to call it every frame. Queuing several animations on the same item with increasing delays lets you
+	 * build keyframe sequences, since each animation starts from the value the item has when it begins.
+	 * Only usable with types that support multiplication by a float and addition.
+	 * @param index The index of the item to animate.
+	 * @param target The value the item will have at the end of the animation.
+	 * @param duration The length of the animation, in seconds.
+	 * @param easing The easing curve of the animation.
+	 * @param delay The time to wait before starting the animation, in seconds.
+	 */
+	void animateTo(size_t index, const ParameterType& target, float duration, Easing easing = Easing::Linear,
+				   float delay = 0)
+	{
+		if (index >= parameters.size())
+		{
+			ofLogNotice("ofxParameterCollection") << "animateTo: Index out of bounds. Index: " << index;
+			return;
+		}
+
+		tweens.indices.push_back(index);
+		tweens.from.push_back(parameters[index]->get());
+		tweens.to.push_back(target);
+		tweens.startTimes.push_back(ofGetElapsedTimef() + delay);
+		tweens.durations.push_back(duration);
+		tweens.easings.push_back(easing);
+		tweens.started.push_back(0);
+	}
+
+	/**
+	 * @brief Advances all of the active animations and writes the resulting values through setValuesAt, so
+	 * that the collectionValuesChangedEvent fires once per call rather than once per animated item.
+	 * Finished animations are removed.
+	 * @param time The current time in seconds. Defaults to ofGetElapsedTimef(), which is the clock used
+	 * by animateTo.
+	 * @param notify If true, fires the collectionValuesChangedEvent when any value was written.
+	 */
+	void updateAnimations(float time = ofGetElapsedTimef(), bool notify = true)
+	{
+		const size_t count = tweens.indices.size();
+		if (count == 0) return;
+
+		// Normalized progress of every tween. Tweens that haven't started yet get a negative value.
+		tweens.progress.resize(count);
+		const float* startTimes = tweens.startTimes.data();
+		const float* durations = tweens.durations.data();
+		float* progress = tweens.progress.data();
+		for (size_t i = 0; i < count; i++)
+		{
+			const float elapsed = time - startTimes[i];
+			const float normalized = durations[i] > 0 ? elapsed / durations[i] : 1.f;
+			progress[i] = elapsed < 0 ? -1.f : std::min(normalized, 1.f);
+		}
+
+		// Eased progress, evaluated in one branch-free pass per curve in use
+		tweens.eased.resize(count);
+		const Easing* easings = tweens.easings.data();
+		float* eased = tweens.eased.data();
+		uint32_t usedCurves = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			usedCurves |= 1u << uint32_t(easings[i]);
+		}
+		easePass<Easing::Linear>(usedCurves, easings, progress, eased, count);
+		easePass<Easing::QuadIn>(usedCurves, easings, progress, eased, count);
+		easePass<Easing::QuadOut>(usedCurves, easings, progress, eased, count);
+		easePass<Easing::QuadInOut>(usedCurves, easings, progress, eased, count);
+		easePass<Easing::CubicIn>(usedCurves, easings, progress, eased, count);
+		easePass<Easing::CubicOut>(usedCurves, easings, progress, eased, count);
+		easePass<Easing::CubicInOut>(usedCurves, easings, progress, eased, count);
+		easePass<Easing::SineInOut>(usedCurves, easings, progress, eased, count);
+
+		animatedIndices.clear();
+		animatedValues.clear();
+		if (animatedSlots.size() < parameters.size()) animatedSlots.resize(parameters.size(), SIZE_MAX);
+		size_t active = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			const size_t index = tweens.indices[i];
+			if (index >= parameters.size()) continue; // The item was removed, drop the tween
+			if (progress[i] < 0)
+			{
+				keepTween(i, active++);
+				continue;
+			}
+			if (!tweens.started[i])
+			{
+				// Start from the value the item has now, so that queued tweens chain like keyframes. If an
+				// earlier tween on the same item wrote a value during this update, that value is the current one.
+				const size_t written = animatedSlots[index];
+				tweens.from[i] = written != SIZE_MAX ? animatedValues[written] : parameters[index]->get();
+				tweens.started[i] = 1;
+			}
+			animatedSlots[index] = animatedValues.size();
+			animatedIndices.push_back(index);
+			animatedValues.push_back(lerpValue(tweens.from[i], tweens.to[i], eased[i]));
+			if (progress[i] < 1.f) keepTween(i, active++);
+		}
+		resizeTweens(active);
+		for (auto index : animatedIndices)
+		{
+			animatedSlots[index] = SIZE_MAX;
+		}
+
+		if (!animatedIndices.empty()) setValuesAt(animatedIndices, animatedValues, notify);
+	}
+
+	/**
+	 * @brief Returns true if there are animations that have not finished.
+	 */
+	bool isAnimating() const
+	{
+		return !tweens.indices.empty();
+	}
+
+	/**
+	 * @brief Removes all of the active animations of the item at index. The item keeps its current value.
+	 */
+	void stopAnimation(size_t index)
+	{
+		size_t active = 0;
+		for (size_t i = 0; i < tweens.indices.size(); i++)
+		{
+			if (tweens.indices[i] != index) keepTween(i, active++);
+		}
+		resizeTweens(active);
+	}
+
+	/**
+	 * @brief Removes all of the active animations. The items keep their current values.
+	 */
+	void stopAnimations()
+	{
+		resizeTweens(0);
+	}
+
+	/**
+	 * @brief Evaluates an easing curve at the normalized time t.
+	 */
+	static float ease(Easing easing, float t)
+	{
+		switch (easing)
+		{
+			case Easing::QuadIn:
+				return t * t;
+			case Easing::QuadOut:
+				return t * (2.f - t);
+			case Easing::QuadInOut:
+				return t < 0.5f ? 2.f * t * t : -1.f + (4.f - 2.f * t) * t;
+			case Easing::CubicIn:
+				return t * t * t;
+			case Easing::CubicOut:
+			{
+				const float u = t - 1.f;
+				return u * u * u + 1.f;
+			}
+			case Easing::CubicInOut:
+			{
+				if (t < 0.5f) return 4.f * t * t * t;
+				const float u = 2.f * t - 2.f;
+				return 0.5f * u * u * u + 1.f;
+			}
+			case Easing::SineInOut:
+				return 0.5f * (1.f - std::cos(t * glm::pi<float>()));
+			case Easing::Linear:
+			default:
+				return t;
+		}
+	}
+
+protected:
+	/**
+	 * @brief Writes ease(Curve, progress) to eased for the tweens that use Curve, if any do. The curve is a
+	 * template argument so that the switch in ease folds away and the loop can be vectorized.
+	 */
+	template<Easing Curve>
+	static void easePass(uint32_t usedCurves, const Easing* easings, const float* progress, float* eased, size_t count)
+	{
+		if (!(usedCurves & (1u << uint32_t(Curve)))) return;
+		for (size_t i = 0; i < count; i++)
+		{
+			const float value = ease(Curve, progress[i]);
+			eased[i] = easings[i] == Curve ? value : eased[i];
+		}
+	}
+
+	/**
+	 * @brief Moves the tween at position from to position to, compacting the tween arrays in place.
+	 */
+	void keepTween(size_t from, size_t to)
+	{
+		if (from == to) return;
+		tweens.indices[to] = tweens.indices[from];
+		tweens.from[to] = tweens.from[from];
+		tweens.to[to] = tweens.to[from];
+		tweens.startTimes[to] = tweens.startTimes[from];
+		tweens.durations[to] = tweens.durations[from];
+		tweens.easings[to] = tweens.easings[from];
+		tweens.started[to] = tweens.started[from];
+	}
+
+	void resizeTweens(size_t count)
+	{
+		tweens.indices.resize(count);
+		tweens.from.resize(count);
+		tweens.to.resize(count);
+		tweens.startTimes.resize(count);
+		tweens.durations.resize(count);
+		tweens.easings.resize(count);
+		tweens.started.resize(count);
+	}
+
+	/**
+	 * @brief Sets permutation to the identity for the current number of items.
+	 */
+	void resetPermutation()
+	{
+		permutation.resize(parameters.size());
+		for (size_t i = 0; i < permutation.size(); i++)
+		{
+			permutation[i] = i;
+		}
+	}
+
+	/**
+	 * @brief Points the active animations at the new positions of their items after a reorder.
+	 */
+	void applyPermutationToTweens()
+	{
+		if (tweens.indices.empty()) return;
+		std::vector<size_t> newIndices(permutation.size());
+		for (size_t i = 0; i < permutation.size(); i++)
+		{
+			newIndices[permutation[i]] = i;
+		}
+		for (auto& index : tweens.indices)
+		{
+			if (index < newIndices.size()) index = newIndices[index];
+		}
+	}
+
+	/**
+	 * @brief Notifies the listeners of the collectionReorderedEvent.
+	 */
+	void notifyReordered()
+	{
+		OFX_PC_TRACE_SCOPE("collectionReorderedEvent");
+		OFX_PC_STATS(stats.reorderedEvents++);
+		OFX_PC_STATS(stats.listenerInvocations += collectionReorderedEvent.size());
+		collectionReorderedEvent.notify(*this);
+	}
+
+	/**
+	 * @brief Removes the items listed in removedIndices, which must be sorted, unique and in bounds. The values
+	 * of the remaining items are compacted into the first ofParameters and the rest are trimmed.
+	 */
+	size_t removeSortedIndices(bool notify)
+	{
+		OFX_PC_TRACE_SCOPE("removeIndices");
+		if (removedIndices.empty()) return 0;
+
+		const size_t count = parameters.size();
+		size_t write = removedIndices.front();
+		size_t next = 0;
+		for (size_t read = write; read < count; read++)
+		{
+			if (next < removedIndices.size() && removedIndices[next] == read)
+			{
+				next++;
+				continue;
+			}
+			parameters[write++]->setWithoutEventNotifications(parameters[read]->get());
+		}
+
+		size_t active = 0;
+		for (size_t i = 0; i < tweens.indices.size(); i++)
+		{
+			auto lower = std::lower_bound(removedIndices.begin(), removedIndices.end(), tweens.indices[i]);
+			if (lower != removedIndices.end() && *lower == tweens.indices[i]) continue;
+			tweens.indices[i] -= lower - removedIndices.begin();
+			keepTween(i, active++);
+		}
+		resizeTweens(active);
+
+		removedRanges.clear();
+		for (auto index : removedIndices)
+		{
+			if (!removedRanges.empty() && removedRanges.back().begin + removedRanges.back().count == index)
+			{
+				removedRanges.back().count++;
+			}
+			else
+			{
+				removedRanges.push_back({index, 1});
+			}
+		}
+
+		trimItems(write);
+		if (notify) this->notify();
+		removedRanges.clear();
+		return count - write;
+	}
+
+	/**
+	 * @brief Destroys the items past the first count, without touching the others.
+	 */
+	void trimItems(size_t count)
+	{
+		OFX_PC_STATS(stats.itemsDestroyed += parameters.size() - std::min(count, parameters.size()));
+		while (parameters.size() > count)
+		{
+			parameterGroup.remove(parameters.size() - 1);
+			parameterIndices.erase(parameters.back().get());
+			parameters.pop_back();
+		}
+		valueListeners.erase(valueListeners.begin() + std::min(count, valueListeners.size()), valueListeners.end());
+		assert(parameters.size() == parameterGroup.size());
+	}
+
+	/**
+	 * @brief Adds or removes items at the end of the collection until it holds count items. Does not notify.
+	 * @return true if the size of the collection changed.
+	 */
+	bool resizeItems(size_t count)
+	{
+		if (count == parameters.size()) return false;
+		if (count > parameters.size())
+		{
+			addEntries(count - parameters.size(), false);
+		}
+		else
+		{
+			trimItems(count);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Bytes allocated on the heap by a value, on top of sizeof(value).
+	 */
+	static size_t heapSize(const std::string& value)
+	{
+		// Short strings are stored inline
+		static const size_t inlineCapacity = std::string().capacity();
+		return value.capacity() > inlineCapacity ? value.capacity() + 1 : 0;
+	}
+
+	template<typename T>
+	static size_t heapSize(const T&)
+	{
+		return 0;
+	}
+
+	/**
+	 * @brief Bytes allocated on the heap by a string of the given length, assuming it wasn't over-allocated.
+	 */
+	static size_t stringHeapSize(size_t stringLength)
+	{
+		static const size_t inlineCapacity = std::string().capacity();
+		return stringLength > inlineCapacity ? stringLength + 1 : 0;
+	}
+
+	/**
+	 * @brief Parses the values of the items serialized in xml into packedValues, in order. Empty elements are
+	 * skipped, like preDeserialize does.
+	 * @return false if the parameter group was not found.
+	 */
+	bool decodeValues(ofXml& xml)
+	{
+		auto path = "//" + parameterGroup.getEscapedName();
+		auto search = xml.findFirst(path);
+		if (!search)
+		{
+			ofLogNotice(__FUNCTION__) << "Could not find " << path;
+			return false;
+		}
+
+		if (search.getAttribute("encoding"))
+		{
+			return decodeCompact(search, parameterGroup.getName(), packedValues,
+								 std::integral_constant<bool, ofxParameterCollectionTraits<ParameterType>::isPacked>());
+		}
+
+		// Text of the items, gathered before parsing them in parallel. It only lives for this call, so a large
+		// collection doesn't keep a string per item around after loading.
+		std::vector<std::string> decodedTexts;
+		packedValues.clear();
+		for (auto child : search.getChildren())
+		{
+			auto text = child.getValue();
+			if (text.size() == 0)
+			{
+				ofLogError(__FUNCTION__) << "Ignoring empty child in group " << parameterGroup.getName();
+				continue;
+			}
+			if (parallelParsing)
+			{
+				decodedTexts.push_back(std::move(text));
+			}
+			else
+			{
+				packedValues.emplace_back();
+				parseValue(text, packedValues.back());
+			}
+		}
+
+		if (parallelParsing)
+		{
+			OFX_PC_TRACE_SCOPE("parseValues");
+			packedValues.resize(decodedTexts.size());
+			ParameterType* values = packedValues.data();
+			const std::string* texts = decodedTexts.data();
+			ofxParameterCollectionThreadPool::shared().parallelFor(decodedTexts.size(), 4096,
+																   [values, texts](size_t begin, size_t end)
+																   {
+																	   for (size_t i = begin; i < end; i++)
+																	   {
+																		   parseValue(texts[i], values[i]);
+																	   }
+																   });
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Computes the size and the 64 bit FNV-1a hash of the file at path.
+	 * @return false if the file could not be read.
+	 */
+	static bool hashFile(const std::string& path, uint64_t& size, uint64_t& hash)
+	{
+		ofFile file(path, ofFile::ReadOnly, true);
+		if (!file.is_open()) return false;
+
+		std::vector<char> buffer(1 << 16);
+		size = 0;
+		hash = 14695981039346656037ull;
+		while (file)
+		{
+			file.read(buffer.data(), buffer.size());
+			const size_t read = size_t(file.gcount());
+			for (size_t i = 0; i < read; i++)
+			{
+				hash = (hash ^ uint64_t((unsigned char) buffer[i])) * 1099511628211ull;
+			}
+			size += read;
+		}
+		return file.eof();
+	}
+
+	/**
+	 * @brief Loads the values from the cache file at path if it was written for an XML file with the given size
+	 * and hash.
+	 * @return false if there is no valid cache, in which case the collection is left untouched.
+	 */
+	bool readCache(const std::string& path, uint64_t xmlSize, uint64_t xmlHash, bool notify, std::true_type)
+	{
+		ofFile file(path, ofFile::ReadOnly, true);
+		if (!file.is_open()) return false;
+
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		uint32_t valueSize = 0;
+		uint64_t size = 0;
+		uint64_t hash = 0;
+		file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+		file.read(reinterpret_cast<char*>(&version), sizeof(version));
+		file.read(reinterpret_cast<char*>(&valueSize), sizeof(valueSize));
+		file.read(reinterpret_cast<char*>(&size), sizeof(size));
+		file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+		if (!file.good() || magic != cacheMagic || version != cacheVersion || valueSize != sizeof(ParameterType)
+			|| size != xmlSize || hash != xmlHash)
+		{
+			return false;
+		}
+		if (!readValues(file, notify))
+		{
+			ofLogNotice("ofxParameterCollection") << "loadCached: " << path << " is truncated, loading the XML";
+			return false;
+		}
+		return true;
+	}
+
+	bool readCache(const std::string& path, uint64_t xmlSize, uint64_t xmlHash, bool notify, std::false_type)
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Writes the values of the items to the cache file at path, keyed by the size and hash of the XML file
+	 * they were loaded from.
+	 */
+	void writeCache(const std::string& path, uint64_t xmlSize, uint64_t xmlHash, std::true_type)
+	{
+		ofFile file(path, ofFile::WriteOnly, true);
+		if (!file.is_open())
+		{
+			ofLogNotice("ofxParameterCollection") << "loadCached: Could not write " << path;
+			return;
+		}
+
+		const uint32_t magic = cacheMagic;
+		const uint32_t version = cacheVersion;
+		const uint32_t valueSize = sizeof(ParameterType);
+		file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+		file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+		file.write(reinterpret_cast<const char*>(&valueSize), sizeof(valueSize));
+		file.write(reinterpret_cast<const char*>(&xmlSize), sizeof(xmlSize));
+		file.write(reinterpret_cast<const char*>(&xmlHash), sizeof(xmlHash));
+		if (!writeValues(file))
+		{
+			ofLogNotice("ofxParameterCollection") << "loadCached: Could not write " << path;
+		}
+	}
+
+	void writeCache(const std::string& path, uint64_t xmlSize, uint64_t xmlHash, std::false_type)
+	{
+	}
+
+	/**
+	 * @brief Replaces the contents of groupXml with the values of the items in the compact layout.
+	 */
+	void writeCompact(ofXml& groupXml, std::true_type)
+	{
+		auto child = groupXml.getFirstChild();
+		while (child)
+		{
+			auto next = child.getNextSibling();
+			groupXml.removeChild(child);
+			child = next;
+		}
+
+		packValues();
+		std::string payload;
+		const bool text = serializationFormat == SerializationFormat::CompactText
+						  && ofxParameterCollectionCodec<ParameterType>::isComponentwise;
+		if (text)
+		{
+			for (size_t i = 0; i < packedValues.size(); i++)
+			{
+				if (i > 0) payload += ", ";
+				ofxParameterCollectionCodec<ParameterType>::format(packedValues[i], payload);
+			}
+		}
+		else
+		{
+			ofxParameterCollectionCodecDetail::base64Encode(reinterpret_cast<const unsigned char*>(packedValues.data()),
+															packedValues.size() * sizeof(ParameterType), payload);
+		}
+		groupXml.setAttribute("count", packedValues.size());
+		groupXml.setAttribute("encoding", std::string(text ? "csv" : "base64"));
+		groupXml.set(payload);
+	}
+
+	void writeCompact(ofXml&, std::false_type)
+	{
+	}
+
+	/**
+	 * @brief Parses the values stored in the compact layout in groupXml into values. groupName is only used in
+	 * the error messages.
+	 * @return false if the data is invalid.
+	 */
+	static bool decodeCompact(const ofXml& groupXml, const std::string& groupName, std::vector<ParameterType>& values,
+							  std::true_type)
+	{
+		const size_t count = groupXml.getAttribute("count").getUintValue();
+		const std::string encoding = groupXml.getAttribute("encoding").getValue();
+		const std::string payload = groupXml.getValue();
+		// Every value takes at least one character, which guards the resize below against a corrupt count
+		if (count > payload.size() + 1)
+		{
+			ofLogError("ofxParameterCollection") << "Group " << groupName << " claims " << count
+												 << " items but only holds " << payload.size() << " characters";
+			return false;
+		}
+
+		values.resize(count);
+		bool valid = false;
+		if (encoding == "base64")
+		{
+			valid = ofxParameterCollectionCodecDetail::base64Decode(payload.data(), payload.data() + payload.size(),
+																   reinterpret_cast<unsigned char*>(values.data()),
+																   count * sizeof(ParameterType));
+		}
+		else if (encoding == "csv")
+		{
+			const char* first = payload.c_str();
+			const char* last = first + payload.size();
+			size_t parsed = 0;
+			while (parsed < count && ofxParameterCollectionCodec<ParameterType>::parse(first, last, values[parsed]))
+			{
+				parsed++;
+			}
+			ofxParameterCollectionCodecDetail::skipSeparators(first, last);
+			if (parsed < count && first == last)
+			{
+				ofLogWarning("ofxParameterCollection") << "Group " << groupName << " claims " << count
+													   << " items but only holds " << parsed << " values";
+			}
+			else if (parsed == count && first != last)
+			{
+				ofLogWarning("ofxParameterCollection") << "Group " << groupName << " claims " << count
+													   << " items but holds more values, the rest are ignored";
+			}
+			valid = parsed == count;
+		}
+		else
+		{
+			ofLogError("ofxParameterCollection") << "Group " << groupName << " has unknown encoding "
+												 << encoding;
+			return false;
+		}
+
+		if (!valid)
+		{
+			ofLogError("ofxParameterCollection") << "Group " << groupName << " holds invalid "
+												 << encoding << " data";
+		}
+		return valid;
+	}
+
+	static bool decodeCompact(const ofXml&, const std::string& groupName, std::vector<ParameterType>&, std::false_type)
+	{
+		ofLogError("ofxParameterCollection") << "Group " << groupName
+											 << " uses the compact layout, which is only available for trivially"
+											 << " copyable types";
+		return false;
+	}
+
+	/**
+	 * @brief Writes the values in packedValues that differ from the current values of the items, which must be
+	 * as many, then optionally fires the collectionValuesChangedEvent with their indices. If resized, the
+	 * collectionChangedEvent fires first, so that the listeners learn about the new items before their values.
+	 * @return The number of items written.
+	 */
+	size_t applyChangedValues(bool notify, bool resized)
+	{
+		assert(packedValues.size() == parameters.size());
+		changedIndices.clear();
+		const ParameterType* values = packedValues.data();
+		const size_t count = std::min(packedValues.size(), parameters.size());
+		for (size_t i = 0; i < count; i++)
+		{
+			if (!sameValue(parameters[i]->get(), values[i],
+						   std::integral_constant<bool, ofxParameterCollectionTraits<ParameterType>::isPacked>()))
+			{
+				parameters[i]->setWithoutEventNotifications(values[i]);
+				changedIndices.push_back(i);
+			}
+		}
+		const size_t changed = changedIndices.size();
+		if (notify && resized) this->notify();
+		if (notify && changed > 0) notifyValuesChanged();
+		changedIndices.clear();
+		return changed;
+	}
+
+	/**
+	 * @brief Trivially copyable values are compared as raw bytes, which doesn't need operator== and is what
+	 * the binary I/O would see as a change.
+	 */
+	static bool sameValue(const ParameterType& a, const ParameterType& b, std::true_type)
+	{
+		return std::memcmp(&a, &b, sizeof(ParameterType)) == 0;
+	}
+
+	static bool sameValue(const ParameterType& a, const ParameterType& b, std::false_type)
+	{
+		return a == b;
+	}
+
+	/**
+	 * @brief Converts the text of a serialized item to a value with ofxParameterCollectionCodec. Text the codec
+	 * doesn't understand is handed to ofFromString, like ofParameter::fromString would.
+	 */
+	static void parseValue(const std::string& text, ParameterType& value)
+	{
+		if (!ofxParameterCollectionCodec<ParameterType>::parse(text, value))
+		{
+			value = ofFromString<ParameterType>(text);
+		}
+	}
+
+	/**
+	 * @brief Notifies the listeners of the collectionValuesChangedEvent.
+	 */
+	void notifyValuesChanged()
+	{
+		OFX_PC_TRACE_SCOPE("collectionValuesChangedEvent");
+		OFX_PC_STATS(stats.valuesChangedEvents++);
+		OFX_PC_STATS(stats.listenerInvocations += collectionValuesChangedEvent.size());
+		collectionValuesChangedEvent.notify(*this);
+	}
+
+	/**
+	 * @brief Copies the current values of the items into packedValues.
+	 */
+	void packValues()
+	{
+		packedValues.resize(parameters.size());
+		for (size_t i = 0; i < parameters.size(); i++)
+		{
+			packedValues[i] = parameters[i]->get();
+		}
+	}
+
+	/**
+	 * @brief Writes packedValues back into the items without firing their individual events, then optionally
+	 * fires the collectionValuesChangedEvent. If resized, the collectionChangedEvent fires before it.
+	 */
+	void applyPackedValues(bool notify, bool resized = false)
+	{
+		assert(packedValues.size() == parameters.size());
+		for (size_t i = 0; i < parameters.size(); i++)
+		{
+			parameters[i]->setWithoutEventNotifications(packedValues[i]);
+		}
+		if (notify && resized) this->notify();
+		if (notify) notifyValuesChanged();
+	}
+
+	/**
+	 * @brief Linear interpolation written as a weighted sum, so that it works with types that clamp on
+	 * subtraction (i.e. ofColor) as well as with numbers and glm vectors.
+	 */
+	static ParameterType lerpValue(const ParameterType& a, const ParameterType& b, float t)
+	{
+		return static_cast<ParameterType>(a * (1.f - t) + b * t);
 	}
 
-protected:
 	/**
  	* @brief Creates an ofParameter with a null value and adds it the collection. This is mostly useful to get
  	* the ofParameterGroup ready for deserialization, so you shouldn't have to call this method.
@@ -403,7 +2358,7 @@ protected:
  	*/
 	void addEntry(bool notify = true)
 	{
-		ParameterType value;
+		ParameterType value{};
 		addItem(value, notify);
 	}
 
@@ -413,9 +2368,9 @@ protected:
 	 * @param count
 	 * @param notify determines whether the collectionChangedEvent fires. The default is true.
 	 */
-	void addEntries(int count, bool notify = true)
+	void addEntries(size_t count, bool notify = true)
 	{
-		for (int i = 0; i < count; i++)
+		for (size_t i = 0; i < count; i++)
 		{
 			addEntry(notify);
 		}
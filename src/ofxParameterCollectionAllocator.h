@@ -0,0 +1,72 @@
+#ifndef OFX_PARAMETER_COLLECTION_ALLOCATOR_H
+#define OFX_PARAMETER_COLLECTION_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+
+/**
+ * @brief Bytes currently allocated by the containers of an ofxParameterCollection, by category. Kept up to date
+ * by ofxParameterCollectionAllocator, see ofxParameterCollection::memoryUsage.
+ */
+struct ofxParameterCollectionAllocationCounters
+{
+	size_t items = 0; // The index of item positions
+	size_t itemBlocks = 0; // The blocks made by allocate_shared, each one a control block and an ofParameter
+	size_t listeners = 0; // The vector of per-item value listeners
+	size_t presets = 0; // The nodes of the preset map
+};
+
+/**
+ * @brief A std::allocator that adds the bytes it hands out to one of the fields of an
+ * ofxParameterCollectionAllocationCounters, and subtracts them when they are freed.
+ *
+ * The counters are shared, so that an item still held by a shared_ptr outside of the collection can be freed
+ * safely after the collection is gone. The counts are not atomic: like the rest of the collection, they must only
+ * be touched from one thread at a time.
+ */
+template<typename T>
+class ofxParameterCollectionAllocator
+{
+public:
+	using value_type = T;
+	using Counter = size_t ofxParameterCollectionAllocationCounters::*;
+
+	std::shared_ptr<ofxParameterCollectionAllocationCounters> counters;
+	Counter counter;
+
+	ofxParameterCollectionAllocator(std::shared_ptr<ofxParameterCollectionAllocationCounters> counters,
+									Counter counter) : counters(std::move(counters)), counter(counter)
+	{}
+
+	template<typename U>
+	ofxParameterCollectionAllocator(const ofxParameterCollectionAllocator<U>& other) :
+			counters(other.counters), counter(other.counter)
+	{}
+
+	T* allocate(size_t n)
+	{
+		T* memory = std::allocator<T>().allocate(n);
+		(*counters).*counter += n * sizeof(T);
+		return memory;
+	}
+
+	void deallocate(T* memory, size_t n)
+	{
+		(*counters).*counter -= n * sizeof(T);
+		std::allocator<T>().deallocate(memory, n);
+	}
+
+	template<typename U>
+	bool operator==(const ofxParameterCollectionAllocator<U>& other) const
+	{
+		return counters == other.counters && counter == other.counter;
+	}
+
+	template<typename U>
+	bool operator!=(const ofxParameterCollectionAllocator<U>& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+#endif //OFX_PARAMETER_COLLECTION_ALLOCATOR_H
@@ -0,0 +1,401 @@
+#ifndef OFX_PARAMETER_COLLECTION_CODEC_H
+#define OFX_PARAMETER_COLLECTION_CODEC_H
+
+#include <ofParameter.h>
+#include <cstdio>
+#include <cstdlib>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+/**
+ * Conversion of collection values to and from the text stored in XML files. ofParameter uses ofToString and
+ * ofFromString, which go through iostreams and allocate a stream for every value; the codec formats and parses
+ * numbers directly into a string, which makes saving and loading numeric collections several times faster.
+ *
+ * The text has the same layout OF uses ("1.5" for numbers, "1.5, 2" for glm vectors, "255, 0, 0, 255" for colors),
+ * so files written by the codec load with ofDeserialize and vice versa. Floats are written with the fewest digits
+ * that read back to the exact same value, so unlike ofToString, which keeps 6 significant digits, saving and
+ * loading doesn't change the values.
+ *
+ * When the standard library implements std::to_chars and std::from_chars for floating point numbers (C++17,
+ * __cpp_lib_to_chars), those are used. Otherwise numbers are formatted with snprintf and parsed with strtol and
+ * strtod, which depend on the C locale: if your app changes LC_NUMERIC, use a locale with '.' as the decimal point.
+ */
+namespace ofxParameterCollectionCodecDetail
+{
+	inline void skipSeparators(const char*& first, const char* last)
+	{
+		while (first != last && (*first == ' ' || *first == ',' || *first == '\t' || *first == '\n' || *first == '\r'))
+		{
+			first++;
+		}
+	}
+
+	/**
+	 * @brief Returns true if only whitespace is left between first and last.
+	 */
+	inline bool onlyWhitespaceLeft(const char* first, const char* last)
+	{
+		while (first != last && (*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r'))
+		{
+			first++;
+		}
+		return first == last;
+	}
+
+#if defined(__cpp_lib_to_chars)
+
+	template<typename Number>
+	void formatNumber(Number value, std::string& out)
+	{
+		char buffer[32];
+		auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+		out.append(buffer, result.ptr);
+	}
+
+	template<typename Number>
+	bool parseNumber(const char*& first, const char* last, Number& value)
+	{
+		skipSeparators(first, last);
+		if (first != last && *first == '+') first++;
+		auto result = std::from_chars(first, last, value);
+		if (result.ec != std::errc()) return false;
+		first = result.ptr;
+		return true;
+	}
+
+#else
+
+	inline void formatNumber(long long value, std::string& out)
+	{
+		char buffer[32];
+		int length = std::snprintf(buffer, sizeof(buffer), "%lld", value);
+		out.append(buffer, length);
+	}
+
+	inline void formatNumber(unsigned long long value, std::string& out)
+	{
+		char buffer[32];
+		int length = std::snprintf(buffer, sizeof(buffer), "%llu", value);
+		out.append(buffer, length);
+	}
+
+	inline void formatNumber(int value, std::string& out) { formatNumber((long long) value, out); }
+	inline void formatNumber(long value, std::string& out) { formatNumber((long long) value, out); }
+	inline void formatNumber(unsigned int value, std::string& out) { formatNumber((unsigned long long) value, out); }
+	inline void formatNumber(unsigned long value, std::string& out) { formatNumber((unsigned long long) value, out); }
+
+	// Uses the shortest precision that reads back to the same value, so that common values stay short.
+	template<typename Real>
+	void formatReal(Real value, int maxPrecision, std::string& out)
+	{
+		char buffer[32];
+		int length = 0;
+		for (int precision = 6; precision <= maxPrecision; precision++)
+		{
+			length = std::snprintf(buffer, sizeof(buffer), "%.*g", precision, double(value));
+			if (Real(std::strtod(buffer, nullptr)) == value) break;
+		}
+		out.append(buffer, length);
+	}
+
+	inline void formatNumber(float value, std::string& out) { formatReal(value, 9, out); }
+	inline void formatNumber(double value, std::string& out) { formatReal(value, 17, out); }
+
+	template<typename Number>
+	bool parseNumber(const char*& first, const char* last, Number& value)
+	{
+		skipSeparators(first, last);
+		// The values are null terminated std::strings, so strto* stop at last at the latest
+		char* end = nullptr;
+		if (std::is_floating_point<Number>::value)
+		{
+			value = Number(std::strtod(first, &end));
+		}
+		else if (std::is_signed<Number>::value)
+		{
+			value = Number(std::strtoll(first, &end, 10));
+		}
+		else
+		{
+			value = Number(std::strtoull(first, &end, 10));
+		}
+		if (end == first || end > last) return false;
+		first = end;
+		return true;
+	}
+
+#endif
+
+	// Colors store their components as unsigned char or unsigned short, which OF writes as numbers
+	template<typename Component>
+	void formatComponent(Component value, std::string& out)
+	{
+		formatNumber(value, out);
+	}
+
+	inline void formatComponent(unsigned char value, std::string& out)
+	{
+		formatNumber((unsigned int) value, out);
+	}
+
+	inline void formatComponent(unsigned short value, std::string& out)
+	{
+		formatNumber((unsigned int) value, out);
+	}
+
+	template<typename Component>
+	bool parseComponent(const char*& first, const char* last, Component& value)
+	{
+		return parseNumber(first, last, value);
+	}
+
+	inline bool parseComponent(const char*& first, const char* last, unsigned char& value)
+	{
+		unsigned int wide = 0;
+		if (!parseNumber(first, last, wide)) return false;
+		value = (unsigned char) wide;
+		return true;
+	}
+
+	inline bool parseComponent(const char*& first, const char* last, unsigned short& value)
+	{
+		unsigned int wide = 0;
+		if (!parseNumber(first, last, wide)) return false;
+		value = (unsigned short) wide;
+		return true;
+	}
+
+	template<typename Component>
+	void formatComponents(const Component* components, size_t count, std::string& out)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			if (i > 0) out += ", ";
+			formatComponent(components[i], out);
+		}
+	}
+
+	template<typename Component>
+	bool parseComponents(const char*& first, const char* last, Component* components, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			if (!parseComponent(first, last, components[i])) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Appends size bytes of data to out as base64 (RFC 4648, with padding).
+	 */
+	inline void base64Encode(const unsigned char* data, size_t size, std::string& out)
+	{
+		static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		out.reserve(out.size() + (size + 2) / 3 * 4);
+		size_t i = 0;
+		for (; i + 2 < size; i += 3)
+		{
+			uint32_t block = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+			out += alphabet[(block >> 18) & 63];
+			out += alphabet[(block >> 12) & 63];
+			out += alphabet[(block >> 6) & 63];
+			out += alphabet[block & 63];
+		}
+		if (i < size)
+		{
+			uint32_t block = uint32_t(data[i]) << 16;
+			if (i + 1 < size) block |= uint32_t(data[i + 1]) << 8;
+			out += alphabet[(block >> 18) & 63];
+			out += alphabet[(block >> 12) & 63];
+			out += i + 1 < size ? alphabet[(block >> 6) & 63] : '=';
+			out += '=';
+		}
+	}
+
+	/**
+	 * @brief Decodes base64 text into exactly size bytes, ignoring whitespace.
+	 * @return false if the text is not valid base64 or doesn't hold size bytes.
+	 */
+	inline bool base64Decode(const char* first, const char* last, unsigned char* out, size_t size)
+	{
+		size_t written = 0;
+		uint32_t block = 0;
+		int bits = 0;
+		for (; first != last; first++)
+		{
+			char c = *first;
+			int value;
+			if (c >= 'A' && c <= 'Z') value = c - 'A';
+			else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+			else if (c >= '0' && c <= '9') value = c - '0' + 52;
+			else if (c == '+') value = 62;
+			else if (c == '/') value = 63;
+			else if (c == '=') break;
+			else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') continue;
+			else return false;
+
+			block = (block << 6) | uint32_t(value);
+			bits += 6;
+			if (bits >= 8)
+			{
+				bits -= 8;
+				if (written == size) return false;
+				out[written++] = (unsigned char) ((block >> bits) & 0xff);
+			}
+		}
+		return written == size;
+	}
+}
+
+/**
+ * @brief Formats and parses the text of one collection value. The primary template falls back to ofToString and
+ * ofFromString, the specializations below handle numbers, glm vectors and colors.
+ *
+ * The specializations are also componentwise: their text is a list of numbers separated by commas, so a sequence
+ * of values joined with ", " can be parsed back one value after the other with the parse overload that takes a
+ * cursor. The compact XML layout of ofxParameterCollection relies on that.
+ */
+template<typename ParameterType>
+struct ofxParameterCollectionCodec
+{
+	static constexpr bool isComponentwise = false;
+
+	/**
+	 * @brief Appends the text of value to out.
+	 */
+	static void format(const ParameterType& value, std::string& out)
+	{
+		out += ofToString(value);
+	}
+
+	/**
+	 * @brief Parses text into value.
+	 * @return false if the text could not be parsed, in which case value is unspecified.
+	 */
+	static bool parse(const std::string& text, ParameterType& value)
+	{
+		value = ofFromString<ParameterType>(text);
+		return true;
+	}
+
+	/**
+	 * @brief Parsing from a cursor is only possible for componentwise types.
+	 */
+	static bool parse(const char*&, const char*, ParameterType&)
+	{
+		return false;
+	}
+};
+
+template<typename Number>
+struct ofxParameterCollectionNumberCodec
+{
+	static constexpr bool isComponentwise = true;
+
+	static void format(Number value, std::string& out)
+	{
+		ofxParameterCollectionCodecDetail::formatNumber(value, out);
+	}
+
+	/**
+	 * @brief Parses text, which must hold exactly one value, into value.
+	 */
+	static bool parse(const std::string& text, Number& value)
+	{
+		const char* first = text.c_str();
+		const char* last = first + text.size();
+		return parse(first, last, value) && ofxParameterCollectionCodecDetail::onlyWhitespaceLeft(first, last);
+	}
+
+	/**
+	 * @brief Parses one value starting at first, skipping the separators before it, and advances first past it.
+	 * The text must be null terminated at or after last.
+	 */
+	static bool parse(const char*& first, const char* last, Number& value)
+	{
+		return ofxParameterCollectionCodecDetail::parseNumber(first, last, value);
+	}
+};
+
+template<>
+struct ofxParameterCollectionCodec<int> : ofxParameterCollectionNumberCodec<int>
+{
+};
+
+template<>
+struct ofxParameterCollectionCodec<unsigned int> : ofxParameterCollectionNumberCodec<unsigned int>
+{
+};
+
+template<>
+struct ofxParameterCollectionCodec<float> : ofxParameterCollectionNumberCodec<float>
+{
+};
+
+template<>
+struct ofxParameterCollectionCodec<double> : ofxParameterCollectionNumberCodec<double>
+{
+};
+
+/**
+ * @brief Codec for types made of a fixed number of numeric components laid out contiguously, like glm vectors
+ * and ofColor.
+ */
+template<typename ParameterType, typename Component, size_t Count>
+struct ofxParameterCollectionComponentCodec
+{
+	static constexpr bool isComponentwise = true;
+
+	static void format(const ParameterType& value, std::string& out)
+	{
+		ofxParameterCollectionCodecDetail::formatComponents(reinterpret_cast<const Component*>(&value), Count, out);
+	}
+
+	/**
+	 * @brief Parses text, which must hold exactly one value, into value.
+	 */
+	static bool parse(const std::string& text, ParameterType& value)
+	{
+		const char* first = text.c_str();
+		const char* last = first + text.size();
+		return parse(first, last, value) && ofxParameterCollectionCodecDetail::onlyWhitespaceLeft(first, last);
+	}
+
+	/**
+	 * @brief Parses one value starting at first, skipping the separators before it, and advances first past it.
+	 * The text must be null terminated at or after last.
+	 */
+	static bool parse(const char*& first, const char* last, ParameterType& value)
+	{
+		return ofxParameterCollectionCodecDetail::parseComponents(first, last, reinterpret_cast<Component*>(&value),
+																  Count);
+	}
+};
+
+template<>
+struct ofxParameterCollectionCodec<glm::vec2> : ofxParameterCollectionComponentCodec<glm::vec2, float, 2>
+{
+};
+
+template<>
+struct ofxParameterCollectionCodec<glm::vec3> : ofxParameterCollectionComponentCodec<glm::vec3, float, 3>
+{
+};
+
+template<>
+struct ofxParameterCollectionCodec<glm::vec4> : ofxParameterCollectionComponentCodec<glm::vec4, float, 4>
+{
+};
+
+template<typename PixelType>
+struct ofxParameterCollectionCodec<ofColor_<PixelType>>
+		: ofxParameterCollectionComponentCodec<ofColor_<PixelType>, PixelType, 4>
+{
+};
+
+#endif //OFX_PARAMETER_COLLECTION_CODEC_H
@@ -0,0 +1,405 @@
+#ifndef OFX_PARAMETER_COLLECTION_RECORDER_H
+#define OFX_PARAMETER_COLLECTION_RECORDER_H
+
+#include "ofxParameterCollection.h"
+#include "ofAppRunner.h"
+
+/**
+ * @brief A single recorded value change. time is in microseconds and frame is in frames, both relative
+ * to the moment the recording started.
+ */
+template<typename ParameterType>
+struct ofxParameterCollectionRecordedEvent
+{
+	uint64_t time;
+	uint64_t frame;
+	uint32_t index;
+	ParameterType value;
+};
+
+/**
+ * @brief Records the value changes of the items in an ofxParameterCollection so that they can be played back
+ * later with ofxParameterCollectionPlayer.
+ *
+ * Events are stored in a ring buffer that is allocated once in setup, so recording does not allocate. When the
+ * buffer is full the oldest events are overwritten. Both single item changes (collectionItemChangedEvent) and batch
+ * writes (collectionValuesChangedEvent) are recorded. A batch write records one event for each item in
+ * getChangedIndices, as is the case with setValuesAt, the animations and reloadValues, or one event for every
+ * item when the batch doesn't report its changes (transform, add, scale, lerpTowards, presets and loading).
+ * Changes to the structure of the collection (adding, removing and reordering items) are not recorded.
+ *
+ * ex:
+ *
+ * ofxParameterCollectionRecorder<float> recorder;
+ * recorder.setup(myParams, 100000);
+ * recorder.start();
+ * // ... later
+ * recorder.stop();
+ * recorder.save("take1.bin");
+ */
+template<typename ParameterType>
+class ofxParameterCollectionRecorder
+{
+protected:
+	ofxParameterCollection<ParameterType>* collection = nullptr;
+	std::vector<ofxParameterCollectionRecordedEvent<ParameterType>> events;
+	size_t head = 0;
+	size_t count = 0;
+	size_t dropped = 0;
+	uint64_t startTime = 0;
+	uint64_t startFrame = 0;
+	bool recording = false;
+	ofEventListeners listeners;
+
+	static constexpr uint32_t fileMagic = 0x5243504f; // "OPCR"
+	static constexpr uint32_t fileVersion = 1;
+
+public:
+	/**
+	 * @brief Readies the recorder for use.
+	 * @param collection The collection to record. It must outlive the recorder.
+	 * @param capacity The maximum number of events held in memory.
+	 */
+	void setup(ofxParameterCollection<ParameterType>& collection, size_t capacity)
+	{
+		this->collection = &collection;
+		events.resize(std::max<size_t>(capacity, 1));
+		clear();
+		listeners.unsubscribeAll();
+		listeners.push(collection.collectionItemChangedEvent.newListener(
+				[this](ofParameter<ParameterType>& param)
+				{
+					if (!recording) return;
+					int index = this->collection->indexOf(param);
+					if (index >= 0) record(index, param.get());
+				}));
+		listeners.push(collection.collectionValuesChangedEvent.newListener(
+				[this](ofxParameterCollection<ParameterType>& collection)
+				{
+					if (!recording) return;
+					auto& changed = collection.getChangedIndices();
+					if (changed.empty())
+					{
+						size_t index = 0;
+						for (auto& param : collection)
+						{
+							record(index++, param->get());
+						}
+						return;
+					}
+					for (auto index : changed)
+					{
+						record(index, collection.getAt(index)->get());
+					}
+				}));
+	}
+
+	/**
+	 * @brief Discards the recorded events and starts recording. Timestamps are relative to this call.
+	 */
+	void start()
+	{
+		assert(collection != nullptr);
+		clear();
+		startTime = ofGetElapsedTimeMicros();
+		startFrame = ofGetFrameNum();
+		recording = true;
+	}
+
+	/**
+	 * @brief Stops recording. The recorded events are kept until the next call to start or clear.
+	 */
+	void stop()
+	{
+		recording = false;
+	}
+
+	bool isRecording() const
+	{
+		return recording;
+	}
+
+	/**
+	 * @brief Discards the recorded events.
+	 */
+	void clear()
+	{
+		head = 0;
+		count = 0;
+		dropped = 0;
+	}
+
+	/**
+	 * @brief Returns the number of events currently held by the recorder.
+	 */
+	size_t size() const
+	{
+		return count;
+	}
+
+	/**
+	 * @brief Returns the number of events that were overwritten because the buffer was full.
+	 */
+	size_t getNumDropped() const
+	{
+		return dropped;
+	}
+
+	/**
+	 * @brief Returns the recorded event at index, where 0 is the oldest event held by the recorder.
+	 */
+	const ofxParameterCollectionRecordedEvent<ParameterType>& getEvent(size_t index) const
+	{
+		assert(index < count);
+		return events[(head + events.size() - count + index) % events.size()];
+	}
+
+	/**
+	 * @brief Returns a copy of the recorded events in chronological order.
+	 */
+	std::vector<ofxParameterCollectionRecordedEvent<ParameterType>> getEvents() const
+	{
+		std::vector<ofxParameterCollectionRecordedEvent<ParameterType>> ordered;
+		ordered.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			ordered.push_back(getEvent(i));
+		}
+		return ordered;
+	}
+
+	/**
+	 * @brief Writes the recorded events to a binary file. Only available for trivially copyable types.
+	 * The file holds a small header followed by the events in chronological order.
+	 * @return false if the file could not be written.
+	 */
+	bool save(const std::string& path) const
+	{
+		static_assert(std::is_trivially_copyable<ParameterType>::value,
+					  "ofxParameterCollectionRecorder can only save trivially copyable types");
+
+		ofFile file(path, ofFile::WriteOnly, true);
+		if (!file.is_open())
+		{
+			ofLogError("ofxParameterCollectionRecorder") << "save: Could not open " << path;
+			return false;
+		}
+
+		const uint32_t magic = fileMagic;
+		const uint32_t version = fileVersion;
+		const uint32_t valueSize = sizeof(ParameterType);
+		const uint64_t eventCount = count;
+		file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+		file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+		file.write(reinterpret_cast<const char*>(&valueSize), sizeof(valueSize));
+		file.write(reinterpret_cast<const char*>(&eventCount), sizeof(eventCount));
+		for (size_t i = 0; i < count; i++)
+		{
+			auto& event = getEvent(i);
+			file.write(reinterpret_cast<const char*>(&event.time), sizeof(event.time));
+			file.write(reinterpret_cast<const char*>(&event.frame), sizeof(event.frame));
+			file.write(reinterpret_cast<const char*>(&event.index), sizeof(event.index));
+			file.write(reinterpret_cast<const char*>(&event.value), sizeof(event.value));
+		}
+		return file.good();
+	}
+
+	/**
+	 * @brief Reads events from a file written by save.
+	 * @param events The vector where the events will be stored. Its previous contents are discarded.
+	 * @return false if the file could not be read or was written for a different type.
+	 */
+	static bool load(const std::string& path, std::vector<ofxParameterCollectionRecordedEvent<ParameterType>>& events)
+	{
+		static_assert(std::is_trivially_copyable<ParameterType>::value,
+					  "ofxParameterCollectionRecorder can only load trivially copyable types");
+
+		ofFile file(path, ofFile::ReadOnly, true);
+		if (!file.is_open())
+		{
+			ofLogError("ofxParameterCollectionRecorder") << "load: Could not open " << path;
+			return false;
+		}
+
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		uint32_t valueSize = 0;
+		uint64_t eventCount = 0;
+		file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+		file.read(reinterpret_cast<char*>(&version), sizeof(version));
+		file.read(reinterpret_cast<char*>(&valueSize), sizeof(valueSize));
+		file.read(reinterpret_cast<char*>(&eventCount), sizeof(eventCount));
+		if (!file.good() || magic != fileMagic || version != fileVersion || valueSize != sizeof(ParameterType))
+		{
+			ofLogError("ofxParameterCollectionRecorder") << "load: " << path << " is not a recording of this type";
+			return false;
+		}
+
+		// Check the count against the file size before allocating, so that a corrupt count fails cleanly
+		const uint64_t headerSize = sizeof(magic) + sizeof(version) + sizeof(valueSize) + sizeof(eventCount);
+		using Event = ofxParameterCollectionRecordedEvent<ParameterType>;
+		const uint64_t eventSize = sizeof(Event::time) + sizeof(Event::frame) + sizeof(Event::index)
+								   + sizeof(Event::value);
+		if (eventCount > (file.getSize() - headerSize) / eventSize)
+		{
+			ofLogError("ofxParameterCollectionRecorder") << "load: " << path << " is truncated";
+			return false;
+		}
+
+		events.resize(eventCount);
+		for (auto& event : events)
+		{
+			file.read(reinterpret_cast<char*>(&event.time), sizeof(event.time));
+			file.read(reinterpret_cast<char*>(&event.frame), sizeof(event.frame));
+			file.read(reinterpret_cast<char*>(&event.index), sizeof(event.index));
+			file.read(reinterpret_cast<char*>(&event.value), sizeof(event.value));
+		}
+		if (!file.good())
+		{
+			ofLogError("ofxParameterCollectionRecorder") << "load: " << path << " is truncated";
+			events.clear();
+			return false;
+		}
+		return true;
+	}
+
+protected:
+	void record(size_t index, const ParameterType& value)
+	{
+		auto& event = events[head];
+		event.time = ofGetElapsedTimeMicros() - startTime;
+		event.frame = ofGetFrameNum() - startFrame;
+		event.index = uint32_t(index);
+		event.value = value;
+
+		head = (head + 1) % events.size();
+		if (count < events.size())
+		{
+			count++;
+		}
+		else
+		{
+			dropped++;
+		}
+	}
+};
+
+/**
+ * @brief Plays back events recorded by ofxParameterCollectionRecorder into an ofxParameterCollection. All of the
+ * events that are due in a call to update are written in one batch through setValuesAt, so the
+ * collectionValuesChangedEvent fires at most once per update.
+ *
+ * ex:
+ *
+ * ofxParameterCollectionPlayer<float> player;
+ * player.setup(myParams);
+ * player.load("take1.bin");
+ * player.play();
+ * // In ofApp::update():
+ * player.update();
+ */
+template<typename ParameterType>
+class ofxParameterCollectionPlayer
+{
+protected:
+	ofxParameterCollection<ParameterType>* collection = nullptr;
+	std::vector<ofxParameterCollectionRecordedEvent<ParameterType>> events;
+	std::vector<size_t> batchIndices;
+	std::vector<ParameterType> batchValues;
+	size_t cursor = 0;
+	uint64_t startTime = 0;
+	uint64_t startFrame = 0;
+	bool playing = false;
+	bool frameAccurate = false;
+
+public:
+	/**
+	 * @brief Readies the player for use.
+	 * @param collection The collection to play into. It must outlive the player.
+	 */
+	void setup(ofxParameterCollection<ParameterType>& collection)
+	{
+		this->collection = &collection;
+	}
+
+	/**
+	 * @brief Loads a recording written by ofxParameterCollectionRecorder::save.
+	 */
+	bool load(const std::string& path)
+	{
+		stop();
+		return ofxParameterCollectionRecorder<ParameterType>::load(path, events);
+	}
+
+	/**
+	 * @brief Uses the events currently held by a recorder.
+	 */
+	void setEvents(const ofxParameterCollectionRecorder<ParameterType>& recorder)
+	{
+		stop();
+		events = recorder.getEvents();
+	}
+
+	/**
+	 * @brief When true, events are scheduled by the frame they were recorded at instead of by their timestamp.
+	 * Use this for deterministic playback that does not depend on the frame rate.
+	 */
+	void setFrameAccurate(bool frameAccurate)
+	{
+		this->frameAccurate = frameAccurate;
+	}
+
+	/**
+	 * @brief Starts playing from the beginning of the recording.
+	 */
+	void play()
+	{
+		assert(collection != nullptr);
+		cursor = 0;
+		startTime = ofGetElapsedTimeMicros();
+		startFrame = ofGetFrameNum();
+		playing = true;
+	}
+
+	void stop()
+	{
+		playing = false;
+		cursor = 0;
+	}
+
+	bool isPlaying() const
+	{
+		return playing;
+	}
+
+	/**
+	 * @brief Writes the events that are due to the collection. Call this every frame while playing.
+	 */
+	void update()
+	{
+		if (!playing) return;
+		advanceTo(frameAccurate ? ofGetFrameNum() - startFrame : ofGetElapsedTimeMicros() - startTime);
+	}
+
+	/**
+	 * @brief Writes all of the events up to position, which is in frames when the player is frame accurate and
+	 * in microseconds otherwise. Useful to drive the playback from your own clock.
+	 */
+	void advanceTo(uint64_t position)
+	{
+		batchIndices.clear();
+		batchValues.clear();
+		while (cursor < events.size())
+		{
+			auto& event = events[cursor];
+			if ((frameAccurate ? event.frame : event.time) > position) break;
+			batchIndices.push_back(event.index);
+			batchValues.push_back(event.value);
+			cursor++;
+		}
+		if (!batchIndices.empty()) collection->setValuesAt(batchIndices, batchValues);
+		if (cursor == events.size()) playing = false;
+	}
+};
+
+#endif //OFX_PARAMETER_COLLECTION_RECORDER_H
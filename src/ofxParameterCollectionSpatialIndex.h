@@ -0,0 +1,552 @@
+#ifndef OFX_PARAMETER_COLLECTION_SPATIAL_INDEX_H
+#define OFX_PARAMETER_COLLECTION_SPATIAL_INDEX_H
+
+#include "ofxParameterCollection.h"
+#include <unordered_map>
+#include <limits>
+
+/**
+ * @brief Number of dimensions of the vector types supported by ofxParameterCollectionSpatialIndex.
+ */
+template<typename VectorType>
+struct ofxParameterCollectionSpatialTraits;
+
+template<>
+struct ofxParameterCollectionSpatialTraits<glm::vec2>
+{
+	static constexpr int dimensions = 2;
+};
+
+template<>
+struct ofxParameterCollectionSpatialTraits<glm::vec3>
+{
+	static constexpr int dimensions = 3;
+};
+
+/**
+ * @brief A uniform grid over the values of an ofxParameterCollection<glm::vec2> or ofxParameterCollection<glm::vec3>,
+ * for hit testing and neighbor queries without scanning the whole collection.
+ *
+ * The index listens to the collection's events and keeps itself up to date: a change in a single item only moves
+ * that item between grid cells, a batch change (collectionValuesChangedEvent) moves the items whose cell changed,
+ * addItem inserts only the new item, removeIf and removeIndices only touch the items after the first removed
+ * one, and move, swap and sort renumber the items without moving them between cells. Other changes in the number
+ * of items (setCollection, clear, loading) rebuild the grid. Queries return item indices, which can be used with
+ * getAt.
+ *
+ * Choose a cell size close to the typical query radius. Much smaller cells make queries visit many empty cells,
+ * much larger cells make them test many items.
+ *
+ * ex:
+ *
+ * ofxParameterCollectionSpatialIndex<glm::vec2> index;
+ * index.setup(positionsCollection, 50);
+ * int hit = index.nearest(glm::vec2(mouseX, mouseY), radius);
+ */
+template<typename VectorType>
+class ofxParameterCollectionSpatialIndex
+{
+protected:
+	static constexpr int dimensions = ofxParameterCollectionSpatialTraits<VectorType>::dimensions;
+
+	ofxParameterCollection<VectorType>* collection = nullptr;
+	float cellSize = 50;
+	std::unordered_map<int64_t, std::vector<size_t>> cells;
+	std::vector<int64_t> itemCells;
+	std::vector<VectorType> positions;
+	ofEventListeners listeners;
+	// Bounds of the cell coordinates of all items, used to stop the nearest neighbor search
+	int minCell[dimensions];
+	int maxCell[dimensions];
+	// Set when a cell on the bounds was emptied, so that the bounds may have to shrink
+	bool boundsStale = false;
+
+public:
+	/**
+	 * @brief Readies the index for use and builds it from the current values of the collection.
+	 * @param collection The collection to index. It must outlive the index.
+	 * @param cellSize The side of the grid cells, in the same units as the values.
+	 */
+	void setup(ofxParameterCollection<VectorType>& collection, float cellSize)
+	{
+		assert(cellSize > 0);
+		this->collection = &collection;
+		this->cellSize = cellSize;
+		listeners.unsubscribeAll();
+		listeners.push(collection.collectionChangedEvent.newListener(
+				[this](ofxParameterCollection<VectorType>& collection)
+				{
+					auto& added = collection.getAddedRange();
+					auto& removed = collection.getRemovedRanges();
+					if (added.count > 0 && added.begin == positions.size()
+						&& added.begin + added.count == collection.size())
+					{
+						appendItems(added.begin);
+					}
+					else if (!removed.empty())
+					{
+						removeItems(removed);
+					}
+					else
+					{
+						refresh();
+					}
+				}));
+		listeners.push(collection.collectionValuesChangedEvent.newListener(
+				[this](ofxParameterCollection<VectorType>& collection)
+				{
+					auto& changed = collection.getChangedIndices();
+					if (changed.empty() || positions.size() != collection.size())
+					{
+						refresh();
+						return;
+					}
+					for (auto index : changed)
+					{
+						updateItem(index);
+					}
+					shrinkBounds();
+				}));
+		listeners.push(collection.collectionReorderedEvent.newListener(
+				[this](ofxParameterCollection<VectorType>& collection)
+				{
+					reorderItems(collection.getPermutation());
+				}));
+		listeners.push(collection.collectionItemChangedEvent.newListener(
+				[this](ofParameter<VectorType>& param)
+				{
+					int index = this->collection->indexOf(param);
+					if (index >= 0) updateItem(index);
+					shrinkBounds();
+				}));
+		rebuild();
+	}
+
+	/**
+	 * @brief Rebuilds the grid from scratch. This happens automatically when the collection is replaced or
+	 * resized by something other than addItem, removeIf or removeIndices.
+	 */
+	void rebuild()
+	{
+		assert(collection != nullptr);
+		cells.clear();
+		const size_t count = collection->size();
+		positions.resize(count);
+		itemCells.resize(count);
+		std::fill(minCell, minCell + dimensions, std::numeric_limits<int>::max());
+		std::fill(maxCell, maxCell + dimensions, std::numeric_limits<int>::min());
+		boundsStale = false;
+		for (size_t i = 0; i < count; i++)
+		{
+			positions[i] = collection->getAt(i)->get();
+			itemCells[i] = insert(i, positions[i]);
+		}
+	}
+
+	/**
+	 * @brief Moves the items whose values changed since the last update to their new cells. This happens
+	 * automatically after bulk operations and reorders.
+	 */
+	void refresh()
+	{
+		assert(collection != nullptr);
+		if (positions.size() != collection->size())
+		{
+			rebuild();
+			return;
+		}
+		for (size_t i = 0; i < positions.size(); i++)
+		{
+			if (collection->getAt(i)->get() != positions[i]) updateItem(i);
+		}
+		shrinkBounds();
+	}
+
+	/**
+	 * @brief Returns the index of the item closest to point, or -1 if there is no item within maxDistance.
+	 */
+	int nearest(const VectorType& point, float maxDistance = std::numeric_limits<float>::max()) const
+	{
+		if (positions.empty()) return -1;
+
+		int center[dimensions];
+		cellCoords(point, center);
+
+		// The grid doesn't need to be searched beyond the cell bounds of the items
+		int maxRing = 0;
+		for (int d = 0; d < dimensions; d++)
+		{
+			maxRing = std::max(maxRing, std::max(center[d] - minCell[d], maxCell[d] - center[d]));
+		}
+
+		int best = -1;
+		float bestDistance2 = maxDistance < std::numeric_limits<float>::max() ? maxDistance * maxDistance
+																			  : std::numeric_limits<float>::max();
+		auto test = [&](size_t index)
+		{
+			float d2 = distance2(positions[index], point);
+			if (d2 <= bestDistance2)
+			{
+				bestDistance2 = d2;
+				best = index;
+			}
+		};
+
+		size_t visited = 0;
+		for (int ring = 0; ring <= maxRing; ring++)
+		{
+			// Every cell in this ring is at least (ring - 1) * cellSize away from point
+			const float ringDistance = std::max(0, ring - 1) * cellSize;
+			if (ringDistance * ringDistance > bestDistance2) break;
+
+			// Only the part of the ring that overlaps the cells of the items needs to be visited
+			int ringFrom[dimensions];
+			int ringTo[dimensions];
+			int from[dimensions];
+			int to[dimensions];
+			bool empty = false;
+			for (int d = 0; d < dimensions; d++)
+			{
+				ringFrom[d] = center[d] - ring;
+				ringTo[d] = center[d] + ring;
+				from[d] = std::max(ringFrom[d], minCell[d]);
+				to[d] = std::min(ringTo[d], maxCell[d]);
+				empty = empty || from[d] > to[d];
+			}
+			if (empty) continue;
+
+			forEachCell(from, to, [&](const int* coords)
+			{
+				bool onRing = false;
+				for (int d = 0; d < dimensions; d++)
+				{
+					onRing = onRing || coords[d] == ringFrom[d] || coords[d] == ringTo[d];
+				}
+				if (!onRing) return;
+				visited++;
+				auto cell = cells.find(cellKey(coords));
+				if (cell == cells.end()) return;
+				for (auto index : cell->second)
+				{
+					test(index);
+				}
+			});
+
+			// When the items are sparse compared to the grid, testing all of them is cheaper than walking rings
+			if (best < 0 && visited > positions.size())
+			{
+				for (size_t i = 0; i < positions.size(); i++)
+				{
+					test(i);
+				}
+				break;
+			}
+		}
+		return best;
+	}
+
+	/**
+	 * @brief Appends to results the indices of the items within radius of center.
+	 */
+	void queryRadius(const VectorType& center, float radius, std::vector<size_t>& results) const
+	{
+		VectorType low = center;
+		VectorType high = center;
+		for (int d = 0; d < dimensions; d++)
+		{
+			low[d] -= radius;
+			high[d] += radius;
+		}
+		const float radius2 = radius * radius;
+		queryCells(low, high, [&](size_t index)
+		{
+			if (distance2(positions[index], center) <= radius2) results.push_back(index);
+		});
+	}
+
+	/**
+	 * @brief Returns the indices of the items within radius of center.
+	 */
+	std::vector<size_t> queryRadius(const VectorType& center, float radius) const
+	{
+		std::vector<size_t> results;
+		queryRadius(center, radius, results);
+		return results;
+	}
+
+	/**
+	 * @brief Appends to results the indices of the items inside the rectangle (or box, for glm::vec3)
+	 * spanned by low and high, inclusive.
+	 */
+	void queryRect(const VectorType& low, const VectorType& high, std::vector<size_t>& results) const
+	{
+		queryCells(low, high, [&](size_t index)
+		{
+			auto& position = positions[index];
+			for (int d = 0; d < dimensions; d++)
+			{
+				if (position[d] < low[d] || position[d] > high[d]) return;
+			}
+			results.push_back(index);
+		});
+	}
+
+	/**
+	 * @brief Returns the indices of the items inside the rectangle (or box, for glm::vec3) spanned by
+	 * low and high, inclusive.
+	 */
+	std::vector<size_t> queryRect(const VectorType& low, const VectorType& high) const
+	{
+		std::vector<size_t> results;
+		queryRect(low, high, results);
+		return results;
+	}
+
+protected:
+	/**
+	 * @brief Inserts the items from index first to the end of the collection, which were appended to it.
+	 */
+	void appendItems(size_t first)
+	{
+		const size_t count = collection->size();
+		positions.resize(count);
+		itemCells.resize(count);
+		for (size_t i = first; i < count; i++)
+		{
+			positions[i] = collection->getAt(i)->get();
+			itemCells[i] = insert(i, positions[i]);
+		}
+	}
+
+	/**
+	 * @brief Drops the removed items from their cells and renumbers the items that followed them, see
+	 * ofxParameterCollection::getRemovedRanges. Only the items after the first removed one are touched.
+	 */
+	void removeItems(const std::vector<ofxParameterCollectionRange>& removed)
+	{
+		size_t removedCount = 0;
+		for (auto& range : removed)
+		{
+			removedCount += range.count;
+		}
+		if (positions.size() != collection->size() + removedCount)
+		{
+			rebuild();
+			return;
+		}
+
+		// Items are visited in increasing order and only ever renumbered down, so the old index being looked up
+		// is never confused with a new index written earlier
+		const size_t first = removed.front().begin;
+		size_t write = first;
+		size_t range = 0;
+		for (size_t read = first; read < positions.size(); read++)
+		{
+			if (range < removed.size() && read >= removed[range].begin)
+			{
+				if (read + 1 == removed[range].begin + removed[range].count) range++;
+				removeFromCell(itemCells[read], positions[read], read);
+				continue;
+			}
+			auto& cell = cells[itemCells[read]];
+			auto position = std::find(cell.begin(), cell.end(), read);
+			assert(position != cell.end());
+			*position = write;
+			positions[write] = positions[read];
+			itemCells[write] = itemCells[read];
+			write++;
+		}
+		positions.resize(write);
+		itemCells.resize(write);
+		shrinkBounds();
+	}
+
+	/**
+	 * @brief Renumbers the items after a move, swap or sort, see ofxParameterCollection::getPermutation. The values
+	 * travel with the items, so none of them changes cell.
+	 */
+	void reorderItems(const std::vector<size_t>& permutation)
+	{
+		if (permutation.size() != positions.size())
+		{
+			rebuild();
+			return;
+		}
+		std::vector<size_t> newIndices(permutation.size());
+		std::vector<VectorType> oldPositions(positions);
+		std::vector<int64_t> oldCells(itemCells);
+		for (size_t i = 0; i < permutation.size(); i++)
+		{
+			newIndices[permutation[i]] = i;
+			positions[i] = oldPositions[permutation[i]];
+			itemCells[i] = oldCells[permutation[i]];
+		}
+		for (auto& cell : cells)
+		{
+			for (auto& index : cell.second)
+			{
+				index = newIndices[index];
+			}
+		}
+	}
+
+	void updateItem(size_t index)
+	{
+		if (index >= positions.size())
+		{
+			rebuild();
+			return;
+		}
+		const VectorType oldPosition = positions[index];
+		positions[index] = collection->getAt(index)->get();
+		int coords[dimensions];
+		cellCoords(positions[index], coords);
+		int64_t key = cellKey(coords);
+		if (key == itemCells[index]) return;
+
+		removeFromCell(itemCells[index], oldPosition, index);
+		itemCells[index] = insert(index, positions[index]);
+	}
+
+	/**
+	 * @brief Takes index out of the cell at key, where it was inserted at position. If that empties a cell on the
+	 * bounds, the bounds are recomputed by the next call to shrinkBounds.
+	 */
+	void removeFromCell(int64_t key, const VectorType& position, size_t index)
+	{
+		auto cell = cells.find(key);
+		if (cell == cells.end()) return;
+		auto found = std::find(cell->second.begin(), cell->second.end(), index);
+		if (found != cell->second.end())
+		{
+			*found = cell->second.back();
+			cell->second.pop_back();
+		}
+		if (!cell->second.empty()) return;
+		cells.erase(cell);
+
+		int coords[dimensions];
+		cellCoords(position, coords);
+		for (int d = 0; d < dimensions; d++)
+		{
+			boundsStale = boundsStale || coords[d] == minCell[d] || coords[d] == maxCell[d];
+		}
+	}
+
+	/**
+	 * @brief Recomputes the cell bounds from the cells that still hold items, if an edge cell was emptied. Bounds
+	 * that are too large stay correct but make every nearest neighbor search and query walk empty cells, so they
+	 * are shrunk after each change. Costs one pass over the occupied cells.
+	 */
+	void shrinkBounds()
+	{
+		if (!boundsStale) return;
+		boundsStale = false;
+		std::fill(minCell, minCell + dimensions, std::numeric_limits<int>::max());
+		std::fill(maxCell, maxCell + dimensions, std::numeric_limits<int>::min());
+		int coords[dimensions];
+		for (auto& cell : cells)
+		{
+			cellCoords(positions[cell.second.front()], coords);
+			for (int d = 0; d < dimensions; d++)
+			{
+				minCell[d] = std::min(minCell[d], coords[d]);
+				maxCell[d] = std::max(maxCell[d], coords[d]);
+			}
+		}
+	}
+
+	int64_t insert(size_t index, const VectorType& position)
+	{
+		int coords[dimensions];
+		cellCoords(position, coords);
+		for (int d = 0; d < dimensions; d++)
+		{
+			minCell[d] = std::min(minCell[d], coords[d]);
+			maxCell[d] = std::max(maxCell[d], coords[d]);
+		}
+		int64_t key = cellKey(coords);
+		cells[key].push_back(index);
+		return key;
+	}
+
+	template<typename Function>
+	void queryCells(const VectorType& low, const VectorType& high, Function function) const
+	{
+		int from[dimensions];
+		int to[dimensions];
+		cellCoords(low, from);
+		cellCoords(high, to);
+		for (int d = 0; d < dimensions; d++)
+		{
+			from[d] = std::max(from[d], minCell[d]);
+			to[d] = std::min(to[d], maxCell[d]);
+			if (from[d] > to[d]) return;
+		}
+		forEachCell(from, to, [&](const int* coords)
+		{
+			auto cell = cells.find(cellKey(coords));
+			if (cell == cells.end()) return;
+			for (auto index : cell->second)
+			{
+				function(index);
+			}
+		});
+	}
+
+	/**
+	 * @brief Calls function with the coordinates of every cell in the inclusive range [from, to].
+	 */
+	template<typename Function>
+	static void forEachCell(const int* from, const int* to, Function function)
+	{
+		int coords[dimensions];
+		std::copy(from, from + dimensions, coords);
+		while (true)
+		{
+			function(coords);
+			int d = 0;
+			while (d < dimensions && coords[d] == to[d])
+			{
+				coords[d] = from[d];
+				d++;
+			}
+			if (d == dimensions) return;
+			coords[d]++;
+		}
+	}
+
+	void cellCoords(const VectorType& position, int* coords) const
+	{
+		for (int d = 0; d < dimensions; d++)
+		{
+			coords[d] = static_cast<int>(std::floor(position[d] / cellSize));
+		}
+	}
+
+	static int64_t cellKey(const int* coords)
+	{
+		// 32 bits per axis in 2D, 21 bits per axis in 3D
+		const int bits = 64 / dimensions;
+		const uint64_t mask = (uint64_t(1) << bits) - 1;
+		uint64_t key = 0;
+		for (int d = 0; d < dimensions; d++)
+		{
+			key = (key << bits) | (uint64_t(int64_t(coords[d])) & mask);
+		}
+		return static_cast<int64_t>(key);
+	}
+
+	static float distance2(const VectorType& a, const VectorType& b)
+	{
+		float sum = 0;
+		for (int d = 0; d < dimensions; d++)
+		{
+			const float delta = a[d] - b[d];
+			sum += delta * delta;
+		}
+		return sum;
+	}
+};
+
+#endif //OFX_PARAMETER_COLLECTION_SPATIAL_INDEX_H
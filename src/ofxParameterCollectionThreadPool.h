@@ -0,0 +1,178 @@
+#ifndef OFX_PARAMETER_COLLECTION_THREAD_POOL_H
+#define OFX_PARAMETER_COLLECTION_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A fixed set of worker threads used by ofxParameterCollection to process the values of large collections
+ * in parallel.
+ *
+ * parallelFor splits a range of indices into chunks, and the workers and the calling thread claim chunks from a
+ * shared atomic counter until none are left. Threads that finish their chunks early keep claiming more, so uneven
+ * work is balanced without a central scheduler. parallelFor blocks until every chunk is done, and calls from
+ * different threads run one at a time. Don't call parallelFor from inside a parallelFor function.
+ */
+class ofxParameterCollectionThreadPool
+{
+protected:
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::mutex jobMutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	uint64_t generation = 0;
+	// Workers that haven't finished the current job yet. Every worker takes part in every job, so when this
+	// reaches 0 no worker can still be touching the job.
+	size_t pendingWorkers = 0;
+	bool stopping = false;
+
+	// The current job. The function is type erased through a plain function pointer so that starting a job
+	// doesn't allocate. Written under mutex, and copied by the workers under mutex when they pick the job up.
+	struct Job
+	{
+		void (* invoke)(void*, size_t, size_t) = nullptr;
+		void* context = nullptr;
+		size_t count = 0;
+		size_t grain = 1;
+		size_t chunkCount = 0;
+	} job;
+	std::atomic<size_t> nextChunk{0};
+
+public:
+	/**
+	 * @brief Returns a pool shared by all collections, with one worker less than the number of hardware threads
+	 * since the calling thread also does work.
+	 */
+	static ofxParameterCollectionThreadPool& shared()
+	{
+		static ofxParameterCollectionThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+		return pool;
+	}
+
+	/**
+	 * @param numWorkers The number of threads to start. With 0 workers, parallelFor runs on the calling thread.
+	 */
+	explicit ofxParameterCollectionThreadPool(size_t numWorkers)
+	{
+		for (size_t i = 0; i < numWorkers; i++)
+		{
+			workers.emplace_back([this]()
+								 {
+									 workerLoop();
+								 });
+		}
+	}
+
+	~ofxParameterCollectionThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	ofxParameterCollectionThreadPool(const ofxParameterCollectionThreadPool&) = delete;
+	ofxParameterCollectionThreadPool& operator=(const ofxParameterCollectionThreadPool&) = delete;
+
+	size_t getNumWorkers() const
+	{
+		return workers.size();
+	}
+
+	/**
+	 * @brief Calls function(begin, end) for consecutive chunks of at most grain indices covering [0, count), in
+	 * parallel, and returns when all of them are done.
+	 */
+	template<typename Function>
+	void parallelFor(size_t count, size_t grain, Function function)
+	{
+		if (count == 0) return;
+		grain = std::max<size_t>(grain, 1);
+		if (workers.empty() || count <= grain)
+		{
+			function(0, count);
+			return;
+		}
+
+		std::lock_guard<std::mutex> jobLock(jobMutex);
+		Job current;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job.invoke = [](void* context, size_t begin, size_t end)
+			{
+				(*static_cast<Function*>(context))(begin, end);
+			};
+			job.context = &function;
+			job.count = count;
+			job.grain = grain;
+			job.chunkCount = (count + grain - 1) / grain;
+			current = job;
+			nextChunk = 0;
+			pendingWorkers = workers.size();
+			generation++;
+		}
+		wake.notify_all();
+
+		runChunks(current);
+
+		// Wait for every worker to pick up and finish this job, so that none of them can claim chunks from
+		// nextChunk after the next job resets it, or call function after it is gone.
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this]()
+		{
+			return pendingWorkers == 0;
+		});
+	}
+
+protected:
+	void runChunks(const Job& current)
+	{
+		while (true)
+		{
+			size_t chunk = nextChunk.fetch_add(1);
+			if (chunk >= current.chunkCount) return;
+			size_t begin = chunk * current.grain;
+			current.invoke(current.context, begin, std::min(begin + current.grain, current.count));
+		}
+	}
+
+	void workerLoop()
+	{
+		uint64_t seenGeneration = 0;
+		while (true)
+		{
+			Job current;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&]()
+				{
+					return stopping || generation != seenGeneration;
+				});
+				if (stopping) return;
+				seenGeneration = generation;
+				current = job;
+			}
+
+			runChunks(current);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				pendingWorkers--;
+			}
+			done.notify_all();
+		}
+	}
+};
+
+#endif //OFX_PARAMETER_COLLECTION_THREAD_POOL_H
@@ -0,0 +1,191 @@
+#ifndef OFX_PARAMETER_COLLECTION_TRACE_H
+#define OFX_PARAMETER_COLLECTION_TRACE_H
+
+/**
+ * Optional tracing of the work done by ofxParameterCollection. Define OFX_PARAMETER_COLLECTION_TRACING in your
+ * compiler flags to record a span for every addItem, removeItem, setCollection, clear, preDeserialize and event
+ * dispatch. Spans are stored in memory and can be written to a Chrome trace_event JSON file, which you can open in
+ * Perfetto (https://ui.perfetto.dev) or chrome://tracing:
+ *
+ * ofxParameterCollectionTrace::get().dump("collection-trace.json");
+ *
+ * When OFX_PARAMETER_COLLECTION_TRACING is not defined the spans compile to nothing.
+ */
+
+#ifdef OFX_PARAMETER_COLLECTION_TRACING
+
+#include <ofParameter.h>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+/**
+ * @brief Process-wide ring buffer of trace spans. Recording a span only claims a slot with an atomic increment, so
+ * spans can be recorded from any thread without locks. The buffer holds the last 65536 spans: when it is full, each
+ * new span overwrites the oldest one, and getNumDropped tells you how many were overwritten.
+ */
+class ofxParameterCollectionTrace
+{
+protected:
+	// The fields are atomics so that dump can read a slot while another thread overwrites it. sequence is the
+	// ticket of the span in the slot plus one, or 0 while the slot is being written.
+	struct Span
+	{
+		std::atomic<const char*> name;
+		std::atomic<uint64_t> start;
+		std::atomic<uint64_t> duration;
+		std::atomic<uint32_t> thread;
+		std::atomic<uint64_t> sequence;
+	};
+
+	std::unique_ptr<Span[]> spans;
+	size_t capacity;
+	std::atomic<uint64_t> next;
+	std::chrono::steady_clock::time_point origin;
+
+	ofxParameterCollectionTrace(size_t capacity) : spans(new Span[capacity]), capacity(capacity), next(0),
+												   origin(std::chrono::steady_clock::now())
+	{
+		for (size_t i = 0; i < capacity; i++)
+		{
+			spans[i].sequence = 0;
+		}
+	}
+
+public:
+	/**
+	 * @brief Returns the trace buffer. It holds the last 65536 spans.
+	 */
+	static ofxParameterCollectionTrace& get()
+	{
+		static ofxParameterCollectionTrace trace(1 << 16);
+		return trace;
+	}
+
+	/**
+	 * @brief Returns the maximum number of spans held by the buffer.
+	 */
+	size_t getCapacity() const
+	{
+		return capacity;
+	}
+
+	/**
+	 * @brief Returns the current time in nanoseconds, relative to the creation of the trace buffer.
+	 */
+	uint64_t now() const
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+	}
+
+	/**
+	 * @brief Records a span, overwriting the oldest one if the buffer is full. name must be a string literal or
+	 * otherwise outlive the trace buffer.
+	 */
+	void record(const char* name, uint64_t start, uint64_t end)
+	{
+		const uint64_t ticket = next.fetch_add(1, std::memory_order_relaxed);
+		auto& span = spans[ticket % capacity];
+		span.sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		span.name.store(name, std::memory_order_relaxed);
+		span.start.store(start, std::memory_order_relaxed);
+		span.duration.store(end - start, std::memory_order_relaxed);
+		span.thread.store(static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())),
+						  std::memory_order_relaxed);
+		span.sequence.store(ticket + 1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Returns the number of spans that were overwritten because the buffer was full.
+	 */
+	size_t getNumDropped() const
+	{
+		const uint64_t recorded = next.load(std::memory_order_relaxed);
+		return recorded > capacity ? recorded - capacity : 0;
+	}
+
+	/**
+	 * @brief Discards all of the recorded spans. Don't call this while other threads are recording spans.
+	 */
+	void clear()
+	{
+		for (size_t i = 0; i < capacity; i++)
+		{
+			spans[i].sequence = 0;
+		}
+		next = 0;
+	}
+
+	/**
+	 * @brief Writes the spans held by the buffer to a Chrome trace_event JSON file, oldest first. Spans that are
+	 * being written by other threads are skipped. Times are written in microseconds with a fixed 3 decimals, so
+	 * they keep their nanosecond resolution however long the app has been running.
+	 * @return false if the file could not be written.
+	 */
+	bool dump(const std::string& path) const
+	{
+		ofFile file(path, ofFile::WriteOnly);
+		if (!file.is_open())
+		{
+			ofLogError("ofxParameterCollectionTrace") << "dump: Could not open " << path;
+			return false;
+		}
+
+		file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+		const uint64_t end = next.load(std::memory_order_acquire);
+		const uint64_t begin = end > capacity ? end - capacity : 0;
+		bool first = true;
+		for (uint64_t ticket = begin; ticket < end; ticket++)
+		{
+			auto& span = spans[ticket % capacity];
+			if (span.sequence.load(std::memory_order_acquire) != ticket + 1) continue;
+			const char* name = span.name.load(std::memory_order_relaxed);
+			const uint64_t start = span.start.load(std::memory_order_relaxed);
+			const uint64_t duration = span.duration.load(std::memory_order_relaxed);
+			const uint32_t thread = span.thread.load(std::memory_order_relaxed);
+			// Skip the span if it was overwritten while it was being read
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (span.sequence.load(std::memory_order_relaxed) != ticket + 1) continue;
+
+			if (!first) file << ",";
+			first = false;
+			file << "\n{\"name\":\"" << name << "\",\"cat\":\"ofxParameterCollection\",\"ph\":\"X\",\"ts\":"
+				 << start / 1000.0 << ",\"dur\":" << duration / 1000.0 << ",\"pid\":0,\"tid\":" << thread << "}";
+		}
+		file << "\n]}\n";
+		return file.good();
+	}
+};
+
+/**
+ * @brief Records a span covering its own lifetime.
+ */
+class ofxParameterCollectionTraceScope
+{
+	const char* name;
+	uint64_t start;
+
+public:
+	ofxParameterCollectionTraceScope(const char* name) : name(name), start(ofxParameterCollectionTrace::get().now())
+	{}
+
+	~ofxParameterCollectionTraceScope()
+	{
+		auto& trace = ofxParameterCollectionTrace::get();
+		trace.record(name, start, trace.now());
+	}
+};
+
+#define OFX_PC_TRACE_CONCAT_(a, b) a##b
+#define OFX_PC_TRACE_CONCAT(a, b) OFX_PC_TRACE_CONCAT_(a, b)
+#define OFX_PC_TRACE_SCOPE(name) ofxParameterCollectionTraceScope OFX_PC_TRACE_CONCAT(ofxPCTraceScope, __LINE__)(name)
+
+#else
+
+#define OFX_PC_TRACE_SCOPE(name)
+
+#endif
+
+#endif //OFX_PARAMETER_COLLECTION_TRACE_H